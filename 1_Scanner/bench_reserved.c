@@ -0,0 +1,70 @@
+/****************************************************/
+/* File: bench_reserved.c                           */
+/* Microbenchmark of identifier classification:     */
+/* linear strcmp search vs. generated perfect hash  */
+/****************************************************/
+
+#include "globals.h"
+#include "reserved.h"
+#include <time.h>
+
+/* the linear lookup previously used by scan.c */
+static struct
+    { char* str;
+      TokenType tok;
+    } reservedWords[MAXRESERVED]
+   = {{"if",IF},{"else",ELSE},{"while",WHILE},
+      {"return",RETURN},{"int",INT},{"void",VOID},
+      /*discarded*/ {"then", THEN}, {"end", END}, {"repeat", REPEAT}, {"until", UNTIL}, {"read", READ}, {"write", WRITE}};
+
+static TokenType linearLookup (const char * s, int len)
+{ int i;
+  for (i=0;i<MAXRESERVED;i++)
+    if (!strcmp(s,reservedWords[i].str))
+      return reservedWords[i].tok;
+  return ID;
+}
+
+/* identifier mix: mostly ordinary names,
+ * some keywords, as in typical C-minus code
+ */
+static char * names[] =
+   { "i","x","gcd","u","v","input","output","value","index","int",
+     "if","return","a","sum","count","temp","else","while","void","main",
+     "buffer","left","right","n","result","low","high","mid","arr","k" };
+
+#define NNAMES ((int)(sizeof(names)/sizeof(names[0])))
+#define ROUNDS 2000000
+
+static double run(TokenType (*lookup)(const char *,int),
+                  int * lens, long * sink)
+{ clock_t start = clock();
+  long r, n = 0;
+  int i;
+  for (r=0;r<ROUNDS;r++)
+    for (i=0;i<NNAMES;i++)
+      n += lookup(names[i],lens[i]);
+  *sink += n;
+  return (double)(clock()-start) / CLOCKS_PER_SEC;
+}
+
+int main(void)
+{ int lens[NNAMES];
+  long sink = 0;
+  double tl, th;
+  int i;
+  for (i=0;i<NNAMES;i++)
+  { lens[i] = strlen(names[i]);
+    if (linearLookup(names[i],lens[i]) != reservedHash(names[i],lens[i]))
+    { fprintf(stderr,"mismatch on %s\n",names[i]);
+      return 1;
+    }
+  }
+  tl = run(linearLookup,lens,&sink);
+  th = run(reservedHash,lens,&sink);
+  printf("identifiers classified: %ld per lookup\n",(long)ROUNDS*NNAMES);
+  printf("linear strcmp : %8.2f ns/id\n",tl*1e9/((double)ROUNDS*NNAMES));
+  printf("perfect hash  : %8.2f ns/id\n",th*1e9/((double)ROUNDS*NNAMES));
+  printf("speedup       : %8.2fx  (%ld)\n",tl/th,sink & 1);
+  return 0;
+}
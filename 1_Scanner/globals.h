@@ -77,6 +77,13 @@ typedef struct treeNode
  */
 extern int EchoSource;
 
+/* MapSource = TRUE causes the hand-written scanner
+ * to map the whole source file into memory (or read
+ * it into one buffer when it cannot be mapped)
+ * instead of reading it a line at a time
+ */
+extern int MapSource;
+
 /* TraceScan = TRUE causes token information to be
  * printed to the listing file as each token is
  * recognized by the scanner
@@ -17,6 +17,22 @@
  */
 #define NO_CODE TRUE
 
+/* set NO_TRACE to TRUE (e.g. with -DNO_TRACE=TRUE) to get
+ * a scanner that only reports the number of tokens, as
+ * used by the scanner benchmark
+ */
+#ifndef NO_TRACE
+#define NO_TRACE FALSE
+#endif
+
+/* set SCAN_MEMORY to TRUE (e.g. with -DSCAN_MEMORY=TRUE)
+ * to load the whole source into memory and have the
+ * scanner scan it in place with scanBuffer
+ */
+#ifndef SCAN_MEMORY
+#define SCAN_MEMORY FALSE
+#endif
+
 #include "util.h"
 #if NO_PARSE
 #include "scan.h"
@@ -28,6 +44,9 @@
 #include "cgen.h"
 #endif
 #endif
+#if SCAN_MEMORY
+#include "scan.h"
+#endif
 #endif
 
 /* allocate global variables */
@@ -37,14 +56,42 @@ FILE * listing;
 FILE * code;
 
 /* allocate and set tracing flags */
+#if NO_TRACE
+int EchoSource = FALSE;
+int MapSource = TRUE;
+int TraceScan = FALSE;
+#else
 int EchoSource = TRUE;
+int MapSource = TRUE;
 int TraceScan = TRUE;
+#endif
 int TraceParse = FALSE;
 int TraceAnalyze = FALSE;
 int TraceCode = FALSE;
 
 int Error = FALSE;
 
+#if SCAN_MEMORY
+/* loadSource reads the whole source file into memory,
+ * followed by the two NULs scanBuffer expects
+ */
+static char * loadSource(int * len)
+{ int cap = 1 << 16, n = 0, r;
+  char * buf = malloc(cap);
+  while (buf != NULL && (r = fread(buf+n,1,cap-2-n,source)) > 0)
+  { n += r;
+    if (n == cap-2) buf = realloc(buf,cap *= 2);
+  }
+  if (buf == NULL)
+  { fprintf(stderr,"Out of memory reading the source\n");
+    exit(1);
+  }
+  buf[n] = buf[n+1] = '\0';
+  *len = n;
+  return buf;
+}
+#endif
+
 main( int argc, char * argv[] )
 { TreeNode * syntaxTree;
   char pgm[120]; /* source code file name */
@@ -62,8 +109,17 @@ main( int argc, char * argv[] )
   }
   listing = stdout; /* send listing to screen */
   fprintf(listing,"\nTINY COMPILATION: %s\n",pgm);
+#if SCAN_MEMORY
+  { int len;
+    char * buf = loadSource(&len);
+    scanBuffer(buf,len);
+  }
+#endif
 #if NO_PARSE
-  while (getToken()!=ENDFILE);
+  { long ntokens = 0;
+    while (getToken()!=ENDFILE) ntokens++;
+    if (!TraceScan) fprintf(listing,"%ld tokens\n",ntokens);
+  }
 #else
   syntaxTree = parse();
   if (TraceParse) {
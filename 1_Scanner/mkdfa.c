@@ -0,0 +1,155 @@
+/****************************************************/
+/* File: mkdfa.c                                    */
+/* Build-time generator of the table-driven         */
+/* scanner DFA for C-minus (dfa.h): a character     */
+/* class map and a dense transition table indexed   */
+/* by state and class, with the accept actions      */
+/* folded into the entries; comment bodies are not  */
+/* in the DFA, which hands them to skipComment      */
+/****************************************************/
+
+#include <stdio.h>
+
+/* states of the DFA, as in the switch of scan.c */
+static char * stateName[] =
+   { "DFA_START","DFA_INEQ","DFA_INLT","DFA_INGT","DFA_INNE","DFA_INOVER",
+     "DFA_INNUM","DFA_INID" };
+
+typedef enum
+   { START,INEQ,INLT,INGT,INNE,INOVER,INNUM,INID,NSTATES }
+   State;
+
+/* character classes; C_EOF stands for the end of
+ * the source, which is not a character
+ */
+typedef enum
+   { C_OTHER,C_DIGIT,C_LETTER,C_BLANK,C_EQ,C_LT,C_GT,C_BANG,
+     C_SLASH,C_STAR,C_PLUS,C_MINUS,C_LPAREN,C_RPAREN,
+     C_LCURLY,C_RCURLY,C_LBRACE,C_RBRACE,C_SEMI,C_COMMA,
+     C_EOF,NCLASSES }
+   Class;
+
+/* the single character tokens, by class from C_STAR */
+static char * singleTok[] =
+   { "TIMES","PLUS","MINUS","LPAREN","RPAREN",
+     "LCURLY","RCURLY","LBRACE","RBRACE","SEMI","COMMA" };
+
+static Class classOf(int c)
+{ if (c >= '0' && c <= '9') return C_DIGIT;
+  if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) return C_LETTER;
+  switch (c)
+  { case ' ': case '\t': case '\n': return C_BLANK;
+    case '=': return C_EQ;
+    case '<': return C_LT;
+    case '>': return C_GT;
+    case '!': return C_BANG;
+    case '/': return C_SLASH;
+    case '*': return C_STAR;
+    case '+': return C_PLUS;
+    case '-': return C_MINUS;
+    case '(': return C_LPAREN;
+    case ')': return C_RPAREN;
+    case '{': return C_LCURLY;
+    case '}': return C_RCURLY;
+    case '[': return C_LBRACE;
+    case ']': return C_RBRACE;
+    case ';': return C_SEMI;
+    case ',': return C_COMMA;
+    default: return C_OTHER;
+  }
+}
+
+/* entry prints the table entry for going to state
+ * next; consume and reset are as in dfa.h
+ */
+static void entry(State next, int consume, int reset)
+{ printf("%s%s%s",stateName[next],
+         consume ? "|DFA_CONSUME" : "",reset ? "|DFA_RESET" : "");
+}
+
+/* accept prints the entry for accepting tok */
+static void accept(char * tok, int consume)
+{ printf("DFA_DONE|DFA_TOKEN(%s)%s",tok,consume ? "|DFA_CONSUME" : "");
+}
+
+/* transition prints the entry for class c in state s */
+static void transition(State s, Class c)
+{ switch (s)
+  { case START:
+      switch (c)
+      { case C_DIGIT: entry(INNUM,1,0); return;
+        case C_LETTER: entry(INID,1,0); return;
+        case C_BLANK: entry(START,1,1); return;
+        case C_EQ: entry(INEQ,1,0); return;
+        case C_LT: entry(INLT,1,0); return;
+        case C_GT: entry(INGT,1,0); return;
+        case C_BANG: entry(INNE,1,0); return;
+        case C_SLASH: entry(INOVER,1,0); return;
+        case C_EOF: accept("ENDFILE",0); return;
+        case C_OTHER: accept("ERROR",1); return;
+        default: accept(singleTok[c-C_STAR],1); return;
+      }
+    case INEQ:
+      if (c == C_EQ) accept("EQ",1); else accept("ASSIGN",0);
+      return;
+    case INLT:
+      if (c == C_EQ) accept("LE",1); else accept("LT",0);
+      return;
+    case INGT:
+      if (c == C_EQ) accept("GE",1); else accept("GT",0);
+      return;
+    case INNE:
+      if (c == C_EQ) accept("NE",1); else accept("ERROR",0);
+      return;
+    case INOVER:
+      if (c == C_STAR) accept("DFA_COMMENT",1); else accept("OVER",0);
+      return;
+    case INNUM:
+      if (c == C_DIGIT) entry(INNUM,1,0); else accept("NUM",0);
+      return;
+    case INID:
+      if (c == C_LETTER) entry(INID,1,0); else accept("ID",0);
+      return;
+    default:
+      return;
+  }
+}
+
+int main(void)
+{ int s, c;
+  printf("/* dfa.h - generated by mkdfa, do not edit */\n\n");
+  printf("#ifndef _DFA_H_\n#define _DFA_H_\n\n");
+  printf("/* a table entry holds the next state (as the index\n"
+         " * of its row in dfaNext) in its low bits, or with\n"
+         " * DFA_DONE the token accepted; DFA_CONSUME moves\n"
+         " * past the character, and DFA_RESET starts the\n"
+         " * lexeme after it\n */\n");
+  printf("#define DFA_STATE 0xFF\n");
+  printf("#define DFA_CONSUME 0x100\n");
+  printf("#define DFA_RESET 0x200\n");
+  printf("#define DFA_DONE 0x400\n");
+  printf("#define DFA_TOKEN(t) ((t) << 16)\n\n");
+  printf("/* DFA_COMMENT is accepted for the opening of a\n"
+         " * comment, whose body is then skipped in bulk\n */\n");
+  printf("#define DFA_COMMENT 0xFF\n\n");
+  printf("#define DFA_NCLASSES %d\n",NCLASSES);
+  printf("#define DFA_EOF %d /* class of the end of the source */\n\n",C_EOF);
+  printf("enum\n   { ");
+  for (s=0;s<NSTATES;s++)
+    printf("%s = %d%s",stateName[s],s*NCLASSES,s+1<NSTATES ? ",\n     " : "");
+  printf(" };\n\n");
+  printf("static const unsigned char dfaClass[256]\n   = {");
+  for (c=0;c<256;c++)
+    printf("%d%s",classOf(c),c+1 < 256 ? (c % 16 == 15 ? ",\n      " : ",") : "};\n\n");
+  printf("static const unsigned int dfaNext[%d*DFA_NCLASSES]\n   = {",NSTATES);
+  for (s=0;s<NSTATES;s++)
+  { printf("/* %s */\n      ",stateName[s]);
+    for (c=0;c<NCLASSES;c++)
+    { transition(s,c);
+      if (c+1 < NCLASSES || s+1 < NSTATES) printf(",\n      ");
+    }
+  }
+  printf("};\n\n");
+  printf("#endif\n");
+  return 0;
+}
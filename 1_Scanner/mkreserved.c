@@ -0,0 +1,87 @@
+/****************************************************/
+/* File: mkreserved.c                               */
+/* Build-time generator of the perfect hash table   */
+/* for the C-minus reserved words (reserved.h)      */
+/****************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+/* the reserved words of C-minus and
+ * the names of their tokens in globals.h
+ */
+static struct
+    { char * str;
+      char * tok;
+    } words[]
+   = {{"if","IF"},{"else","ELSE"},{"while","WHILE"},
+      {"return","RETURN"},{"int","INT"},{"void","VOID"}};
+
+#define NWORDS ((int)(sizeof(words)/sizeof(words[0])))
+
+/* the hash of a word of length len is
+ * (s[0]*a + s[len-1]*b + len) & (size-1)
+ */
+static int hash(const char * s, int len, int a, int b, int size)
+{ return ((unsigned char)s[0]*a + (unsigned char)s[len-1]*b + len)
+         & (size-1);
+}
+
+/* perfect returns TRUE if a, b and size give
+ * a collision free hash over all the words
+ */
+static int perfect(int a, int b, int size)
+{ int used[64] = {0};
+  int i;
+  for (i=0;i<NWORDS;i++)
+  { int h = hash(words[i].str,strlen(words[i].str),a,b,size);
+    if (used[h]) return 0;
+    used[h] = 1;
+  }
+  return 1;
+}
+
+int main(void)
+{ int size, a, b, i, h;
+  int minlen = 1000, maxlen = 0;
+  for (i=0;i<NWORDS;i++)
+  { int len = strlen(words[i].str);
+    if (len < minlen) minlen = len;
+    if (len > maxlen) maxlen = len;
+  }
+  for (size=8;size<=64;size*=2)
+    for (a=0;a<32;a++)
+      for (b=0;b<32;b++)
+        if (perfect(a,b,size)) goto found;
+  fprintf(stderr,"mkreserved: no perfect hash found\n");
+  return 1;
+found:
+  printf("/* reserved.h - generated by mkreserved, do not edit */\n\n");
+  printf("#ifndef _RESERVED_H_\n#define _RESERVED_H_\n\n");
+  printf("#define RESERVED_MINLEN %d\n",minlen);
+  printf("#define RESERVED_MAXLEN %d\n",maxlen);
+  printf("#define RESERVED_SIZE %d\n\n",size);
+  printf("static const struct\n    { const char * str;\n      int len;\n"
+         "      TokenType tok;\n    } reservedTable[RESERVED_SIZE]\n   = {");
+  for (h=0;h<size;h++)
+  { for (i=0;i<NWORDS;i++)
+      if (hash(words[i].str,strlen(words[i].str),a,b,size) == h) break;
+    if (i < NWORDS)
+      printf("{\"%s\",%d,%s}",words[i].str,(int)strlen(words[i].str),
+             words[i].tok);
+    else printf("{\"\",0,ID}");
+    printf(h+1 < size ? ",\n      " : "};\n\n");
+  }
+  printf("/* reservedHash classifies the identifier s of\n"
+         " * length len, returning ID if it is not reserved\n */\n");
+  printf("static TokenType reservedHash(const char * s, int len)\n");
+  printf("{ int h;\n");
+  printf("  if (len < RESERVED_MINLEN || len > RESERVED_MAXLEN) return ID;\n");
+  printf("  h = ((unsigned char)s[0]*%d + (unsigned char)s[len-1]*%d + len)"
+         " & (RESERVED_SIZE-1);\n",a,b);
+  printf("  if (reservedTable[h].len == len &&\n"
+         "      memcmp(s,reservedTable[h].str,len) == 0)\n"
+         "    return reservedTable[h].tok;\n");
+  printf("  return ID;\n}\n\n#endif\n");
+  return 0;
+}
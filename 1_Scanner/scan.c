@@ -8,6 +8,26 @@
 #include "globals.h"
 #include "util.h"
 #include "scan.h"
+#include "reserved.h"
+#include "skip.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+/* set SCAN_TABLE to TRUE (e.g. with -DSCAN_TABLE=TRUE)
+ * to get the table-driven getToken, which runs the
+ * DFA generated into dfa.h by mkdfa over the mapped
+ * source instead of the switch below, skipping
+ * blanks and comment bodies in bulk
+ */
+#ifndef SCAN_TABLE
+#define SCAN_TABLE FALSE
+#endif
+
+#if SCAN_TABLE
+#include "dfa.h"
+#endif
 
 /* states in scanner DFA */
 typedef enum
@@ -17,6 +37,7 @@ typedef enum
 /* lexeme of identifier or reserved word */
 char tokenString[MAXTOKENLEN+1];
 
+#if !SCAN_TABLE
 /* BUFLEN = length of the input buffer for
    source code lines */
 #define BUFLEN 256
@@ -25,12 +46,89 @@ static char lineBuf[BUFLEN]; /* holds the current line */
 static int linepos = 0; /* current position in LineBuf */
 static int bufsize = 0; /* current size of buffer string */
 static int EOF_flag = FALSE; /* corrects ungetNextChar behavior on EOF */
+#endif
+
+/* with MapSource the whole source is held in
+   [srcBuf,srcEnd) and scanned through srcPos;
+   lineEnd is the start of the next unread line */
+static const char * srcBuf = NULL;
+static const char * srcEnd = NULL;
+static const char * srcPos = NULL;
+static const char * lineEnd = NULL;
+
+/* readSource reads the rest of the source stream
+   into a malloc'ed buffer, for inputs that cannot
+   be mapped (pipes, terminals) */
+static const char * readSource(size_t * len)
+{ size_t cap = 1 << 16, n = 0, r;
+  char * buf = malloc(cap);
+  while (buf != NULL && (r = fread(buf+n,1,cap-n,source)) > 0)
+  { n += r;
+    if (n == cap)
+    { char * t = realloc(buf,cap *= 2);
+      if (t == NULL) free(buf);
+      buf = t;
+    }
+  }
+  if (buf == NULL)
+    fprintf(listing,"Out of memory error at line %d\n",lineno);
+  *len = n;
+  return buf;
+}
 
+/* mapSource makes the whole source file available
+   in memory, using mmap for regular files */
+static void mapSource(void)
+{ struct stat st;
+  size_t len = 0;
+  int fd = fileno(source);
+  srcBuf = NULL;
+  if (fstat(fd,&st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0
+      && ftell(source) == 0)
+  { void * m = mmap(NULL,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+    if (m != MAP_FAILED)
+    { madvise(m,st.st_size,MADV_SEQUENTIAL);
+      srcBuf = m;
+      len = st.st_size;
+    }
+  }
+  if (srcBuf == NULL)
+    srcBuf = readSource(&len);
+  srcEnd = srcBuf + len;
+  srcPos = lineEnd = srcBuf;
+}
+
+void scanBuffer(char * buf, int len)
+{ MapSource = TRUE;
+  srcBuf = buf;
+  srcEnd = buf + len;
+  srcPos = lineEnd = srcBuf;
+}
+
+#if !SCAN_TABLE
 /* getNextChar fetches the next non-blank character
    from lineBuf, reading in a new line if lineBuf is
    exhausted */
 static int getNextChar(void)
-{ if (!(linepos < bufsize))
+{ if (MapSource)
+  { if (srcPos == lineEnd) /* at the start of a new line */
+    { const char * nl;
+      if (srcBuf == NULL) mapSource();
+      lineno++;
+      if (srcPos >= srcEnd)
+      { EOF_flag = TRUE;
+        return EOF;
+      }
+      nl = memchr(srcPos,'\n',srcEnd-srcPos);
+      lineEnd = (nl != NULL) ? nl+1 : srcEnd;
+      if (EchoSource)
+      { fprintf(listing,"%4d: ",lineno);
+        fwrite(srcPos,1,lineEnd-srcPos,listing);
+      }
+    }
+    return (unsigned char) *srcPos++;
+  }
+  if (!(linepos < bufsize))
   { lineno++;
     if (fgets(lineBuf,BUFLEN-1,source))
     { if (EchoSource) fprintf(listing,"%4d: %s",lineno,lineBuf);
@@ -49,32 +147,119 @@ static int getNextChar(void)
 /* ungetNextChar backtracks one character
    in lineBuf */
 static void ungetNextChar(void)
-{ if (!EOF_flag) linepos-- ;}
+{ if (!EOF_flag)
+  { if (MapSource) srcPos--;
+    else linepos--;
+  }
+}
 
-/* lookup table of reserved words */
-static struct
-    { char* str;
-      TokenType tok;
-    } reservedWords[MAXRESERVED]
-   = {{"if",IF},{"else",ELSE},{"while",WHILE},
-      {"return",RETURN},{"int",INT},{"void",VOID},
-      /*discarded*/ {"then", THEN}, {"end", END}, {"repeat", REPEAT}, {"until", UNTIL}, {"read", READ}, {"write", WRITE}};
+/* skipRun jumps over a run of blanks (in START)
+   or comment text (in INCOMMENT) in the mapped
+   source, keeping lineno and lineEnd as a call of
+   getNextChar per character would */
+static void skipRun(StateType state)
+{ const char * q;
+  int lines = 0;
+  if (srcBuf == NULL || srcPos >= srcEnd) return;
+  if (state == START) q = skipBlanks(srcPos,srcEnd,&lines);
+  else q = skipComment(srcPos,srcEnd,&lines);
+  if (q == srcPos) return;
+  if (srcPos == lineEnd) lineno++; /* entered the line at srcPos */
+  if (q[-1] == '\n') /* stopped at the start of a new line */
+  { lineno += lines - 1;
+    lineEnd = q;
+  }
+  else if (lines > 0 || srcPos == lineEnd) /* stopped inside a line it entered */
+  { const char * nl = memchr(q,'\n',srcEnd-q);
+    lineno += lines;
+    lineEnd = (nl != NULL) ? nl+1 : srcEnd;
+  }
+  srcPos = q;
+}
+#endif
 
 /* lookup an identifier to see if it is a reserved word */
-/* uses linear search */
-static TokenType reservedLookup (char * s)
-{ int i;
-//  printf("reserved word = %s\n!!!!!",s);
-  for (i=0;i<MAXRESERVED;i++)
-    if (!strcmp(s,reservedWords[i].str)){
-      return reservedWords[i].tok;
-    }
-  return ID;
+/* uses the perfect hash generated into reserved.h */
+static TokenType reservedLookup (const char * s, int len)
+{ return reservedHash(s,len);
 }
 
 /****************************************/
 /* the primary function of the scanner  */
 /****************************************/
+#if SCAN_TABLE
+/* seeLines keeps lineno and the echo of the source
+   as getNextChar would after looking at every
+   character up to last (the end of the source
+   counting as a character) */
+static void seeLines(const char * last)
+{ while (lineEnd <= last && lineEnd < srcEnd)
+  { const char * nl = memchr(lineEnd,'\n',srcEnd-lineEnd);
+    const char * next = (nl != NULL) ? nl+1 : srcEnd;
+    lineno++;
+    if (EchoSource)
+    { fprintf(listing,"%4d: ",lineno);
+      fwrite(lineEnd,1,next-lineEnd,listing);
+    }
+    lineEnd = next;
+  }
+  if (last >= srcEnd) lineno++;
+}
+
+/* function getToken returns the 
+ * next token in source file
+ */
+TokenType getToken(void)
+{ const char * p; /* next character */
+  const char * start; /* start of the lexeme */
+  const char * last; /* last character looked at */
+  unsigned int e; /* current table entry */
+  int state;
+  TokenType currentToken;
+  int len;
+  if (srcBuf == NULL)
+  { MapSource = TRUE;
+    mapSource();
+  }
+  p = srcPos;
+  while (1)
+  { int lines; /* unused: seeLines counts them */
+    const char * q;
+    p = start = skipBlanks(p,srcEnd,&lines);
+    state = DFA_START;
+    do
+    { int c = p < srcEnd ? dfaClass[(unsigned char) *p] : DFA_EOF;
+      e = dfaNext[state + c];
+      last = p;
+      p += (e & DFA_CONSUME) != 0;
+      start = (e & DFA_RESET) ? p : start;
+      state = e & DFA_STATE;
+    } while (!(e & DFA_DONE));
+    if ((e >> 16) != DFA_COMMENT) break;
+    q = skipComment(p,srcEnd,&lines);
+    if (q + 1 >= srcEnd) /* the comment runs to the end */
+    { e = DFA_TOKEN(ENDFILE);
+      p = last = srcEnd;
+      break;
+    }
+    p = q + 2;
+  }
+  srcPos = p;
+  seeLines(last);
+  currentToken = e >> 16;
+  len = p - start;
+  if (len > MAXTOKENLEN) len = MAXTOKENLEN;
+  memcpy(tokenString,start,len);
+  tokenString[len] = '\0';
+  if (currentToken == ID)
+    currentToken = reservedLookup(start,p-start);
+  if (TraceScan) {
+    fprintf(listing,"\t%d: ",lineno);
+    printToken(currentToken,tokenString);
+  }
+  return currentToken;
+} /* end getToken */
+#else
 /* function getToken returns the 
  * next token in source file
  */
@@ -88,7 +273,12 @@ TokenType getToken(void)
    /* flag to indicate save to tokenString */
    int save;
    while (state != DONE)
-   { int c = getNextChar();
+   { int c;
+     /* echoing needs each line, so bulk skipping
+        is only done when EchoSource is off */
+     if (MapSource && !EchoSource && (state == START || state == INCOMMENT))
+       skipRun(state);
+     c = getNextChar();
      save = TRUE;
      switch (state)
      { case START:
@@ -263,7 +453,7 @@ TokenType getToken(void)
      if (state == DONE)
      { tokenString[tokenStringIndex] = '\0';
        if (currentToken == ID)
-         currentToken = reservedLookup(tokenString);
+         currentToken = reservedLookup(tokenString,tokenStringIndex);
      }
    }
    if (TraceScan) {
@@ -272,4 +462,5 @@ TokenType getToken(void)
    }
    return currentToken;
 } /* end getToken */
+#endif
 
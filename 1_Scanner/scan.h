@@ -19,4 +19,12 @@ extern char tokenString[MAXTOKENLEN+1];
  */
 TokenType getToken(void);
 
+/* function scanBuffer makes the scanner take the
+ * source from buf, which holds len characters
+ * followed by two NUL characters; buf is scanned
+ * in place, without copying, and is modified while
+ * it is scanned; call it before the first getToken
+ */
+void scanBuffer(char * buf, int len);
+
 #endif
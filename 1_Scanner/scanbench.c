@@ -0,0 +1,218 @@
+/****************************************************/
+/* File: scanbench.c                                */
+/* Throughput benchmark for the C-minus scanners:   */
+/* generates synthetic corpora and runs each        */
+/* scanner on them, reporting tokens/sec, MB/sec    */
+/* and peak resident set size                       */
+/*                                                  */
+/* usage: scanbench <maxsize> <scanner>...          */
+/*   maxsize: largest corpus, e.g. 64M or 1G        */
+/*   scanner: built with -DNO_TRACE=TRUE, so that   */
+/*            it prints "<n> tokens"                */
+/*                                                  */
+/* runs are timed and checked as in parsebench.c of */
+/* the parser, which should be kept in step         */
+/****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+/* corpora are grown by this factor from 1 KB */
+#define SIZESTEP 32
+
+/* runs per measurement; the fastest is reported */
+#define RUNS 3
+
+typedef enum {IdentHeavy,CommentHeavy,NumberHeavy,LongLines} CorpusKind;
+
+static char * kindName[] = {"ident","comment","number","longline"};
+
+/* rnd is a small LCG so that corpora are reproducible */
+static unsigned long seed = 1;
+static unsigned int rnd(unsigned int n)
+{ seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+  return (unsigned int)(seed >> 33) % n;
+}
+
+static void putIdent(FILE * f)
+{ int len = 1 + rnd(10);
+  while (len-- > 0) putc('a' + rnd(26), f);
+}
+
+static void putNumber(FILE * f)
+{ fprintf(f,"%u",rnd(100000));
+}
+
+static char * ops[] = {"+","-","*","/","<","<=",">",">=","==","!=","="};
+
+/* putStatement writes one statement of the given
+ * kind of corpus, returning the bytes written
+ */
+static long putStatement(FILE * f, CorpusKind kind)
+{ long start = ftell(f);
+  int i, n;
+  switch (kind)
+  { case IdentHeavy:
+    case LongLines:
+      putIdent(f); fputs(" = ",f); putIdent(f);
+      for (i=rnd(4);i>=0;i--)
+      { fprintf(f," %s ",ops[rnd(4)]); putIdent(f); }
+      fputs(kind == LongLines ? "; " : ";\n",f);
+      break;
+    case CommentHeavy:
+      fputs("/* ",f);
+      for (n=2+rnd(6);n>0;n--)
+      { for (i=rnd(12);i>=0;i--) { putIdent(f); putc(' ',f); }
+        fputs("\n * ",f);
+      }
+      fputs("*/\n",f);
+      putIdent(f); fputs(" = ",f); putNumber(f); fputs(";\n",f);
+      break;
+    case NumberHeavy:
+      putIdent(f); putc('[',f); putNumber(f); fputs("] = ",f);
+      putNumber(f);
+      for (i=rnd(4);i>=0;i--)
+      { fprintf(f," %s ",ops[rnd(4)]); putNumber(f); }
+      fputs(";\n",f);
+      break;
+  }
+  return ftell(f) - start;
+}
+
+/* makeCorpus writes about size bytes of the given
+ * kind of corpus into the file path
+ */
+static int makeCorpus(char * path, CorpusKind kind, long size)
+{ FILE * f = fopen(path,"w");
+  long n = 0, line = 0;
+  if (f == NULL) return -1;
+  seed = kind + 1;
+  while (n < size)
+  { long len = putStatement(f,kind);
+    n += len;
+    line += len;
+    if (kind == LongLines && line > 65536)
+    { putc('\n',f);
+      n++;
+      line = 0;
+    }
+  }
+  putc('\n',f);
+  return fclose(f);
+}
+
+/* runScanner runs scanner on path, returning the
+ * elapsed seconds and setting the token count and
+ * peak RSS (KB), or returning -1 on failure
+ */
+static double runScanner(char * scanner, char * path,
+                         long * tokens, long * rss)
+{ int fd[2];
+  pid_t pid;
+  int status;
+  struct rusage ru;
+  struct timespec t0, t1;
+  char out[4096];
+  size_t n = 0;
+  ssize_t r;
+  char * p;
+  if (pipe(fd) != 0) return -1;
+  clock_gettime(CLOCK_MONOTONIC,&t0);
+  pid = fork();
+  if (pid < 0) return -1;
+  if (pid == 0)
+  { dup2(fd[1],1);
+    close(fd[0]);
+    close(fd[1]);
+    execl(scanner,scanner,path,(char *)NULL);
+    _exit(127);
+  }
+  close(fd[1]);
+  while ((r = read(fd[0],out+n,sizeof(out)-1-n)) > 0)
+  { n += r;
+    if (n == sizeof(out)-1) n = 0; /* keep only the tail */
+  }
+  out[n] = '\0';
+  close(fd[0]);
+  if (wait4(pid,&status,0,&ru) < 0) return -1;
+  clock_gettime(CLOCK_MONOTONIC,&t1);
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) return -1;
+  p = strstr(out," tokens");
+  if (p == NULL) return -1;
+  while (p > out && p[-1] >= '0' && p[-1] <= '9') p--;
+  *tokens = atol(p);
+  *rss = ru.ru_maxrss;
+  return (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9;
+}
+
+/* parseSize reads sizes such as 4096, 64K, 16M or 1G */
+static long parseSize(char * s)
+{ char * end;
+  long n = strtol(s,&end,10);
+  switch (*end)
+  { case 'k': case 'K': return n << 10;
+    case 'm': case 'M': return n << 20;
+    case 'g': case 'G': return n << 30;
+    default: return n;
+  }
+}
+
+int main(int argc, char * argv[])
+{ char dir[] = "/tmp/scanbenchXXXXXX";
+  char path[64];
+  long maxSize, size;
+  int kind, s, run;
+  if (argc < 3)
+  { fprintf(stderr,"usage: %s <maxsize> <scanner>...\n",argv[0]);
+    exit(1);
+  }
+  maxSize = parseSize(argv[1]);
+  if (mkdtemp(dir) == NULL)
+  { fprintf(stderr,"cannot create a directory for the corpora\n");
+    exit(1);
+  }
+  sprintf(path,"%s/corpus.cm",dir);
+  printf("%-9s %10s  %-16s %12s %10s %10s %10s\n",
+         "corpus","bytes","scanner","tokens","Mtok/s","MB/s","peakRSS");
+  for (kind=IdentHeavy;kind<=LongLines;kind++)
+    for (size=1024;size<=maxSize;size*=SIZESTEP)
+    { long bytes;
+      FILE * f;
+      if (makeCorpus(path,kind,size) != 0 || (f = fopen(path,"r")) == NULL)
+      { fprintf(stderr,"cannot write %s\n",path);
+        exit(1);
+      }
+      fseek(f,0,SEEK_END);
+      bytes = ftell(f);
+      fclose(f);
+      for (s=2;s<argc;s++)
+      { double best = -1;
+        long tokens = 0, rss = 0;
+        for (run=0;run<RUNS;run++)
+        { long tk, kb;
+          double t = runScanner(argv[s],path,&tk,&kb);
+          if (t < 0) break;
+          if (best < 0 || t < best) best = t;
+          tokens = tk;
+          if (kb > rss) rss = kb;
+        }
+        if (best < 0)
+          printf("%-9s %10ld  %-16s %12s\n",kindName[kind],bytes,argv[s],"failed");
+        else
+          printf("%-9s %10ld  %-16s %12ld %10.2f %10.2f %8.1fMB\n",
+                 kindName[kind],bytes,argv[s],tokens,
+                 tokens/best/1e6,bytes/best/(1<<20),rss/1024.0);
+        fflush(stdout);
+      }
+      remove(path);
+    }
+  rmdir(dir);
+  return 0;
+}
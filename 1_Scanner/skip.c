@@ -0,0 +1,103 @@
+/****************************************************/
+/* File: skip.c                                     */
+/* Bulk skipping of blanks and comment text for     */
+/* the C-minus scanners (SSE2/AVX2 when available)  */
+/****************************************************/
+
+#include "skip.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define VLEN 32
+typedef __m256i vec;
+#define vload(p) _mm256_loadu_si256((const __m256i *)(p))
+#define vsplat(c) _mm256_set1_epi8(c)
+#define veq(a,b) _mm256_cmpeq_epi8(a,b)
+#define vor(a,b) _mm256_or_si256(a,b)
+#define vand(a,b) _mm256_and_si256(a,b)
+#define vmask(a) ((unsigned int)_mm256_movemask_epi8(a))
+#define ALLSET 0xFFFFFFFFu
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define VLEN 16
+typedef __m128i vec;
+#define vload(p) _mm_loadu_si128((const __m128i *)(p))
+#define vsplat(c) _mm_set1_epi8(c)
+#define veq(a,b) _mm_cmpeq_epi8(a,b)
+#define vor(a,b) _mm_or_si128(a,b)
+#define vand(a,b) _mm_and_si128(a,b)
+#define vmask(a) ((unsigned int)_mm_movemask_epi8(a))
+#define ALLSET 0xFFFFu
+#endif
+
+/* bits of m below position i */
+#define BELOW(m,i) ((m) & ((1u << (i)) - 1u))
+
+const char * skipBlanks( const char * p, const char * end, int * lines )
+{ int n = 0;
+#ifdef VLEN
+  vec sp = vsplat(' '), tab = vsplat('\t'), nl = vsplat('\n');
+  while (end - p >= VLEN)
+  { vec v = vload(p);
+    unsigned int m = vmask(veq(v,nl));
+    unsigned int b = vmask(vor(vor(veq(v,sp),veq(v,tab)),veq(v,nl)));
+    if (b != ALLSET)
+    { int i = __builtin_ctz(~b);
+      *lines += n + __builtin_popcount(BELOW(m,i));
+      return p + i;
+    }
+    n += __builtin_popcount(m);
+    p += VLEN;
+  }
+#endif
+  for (; p < end; p++)
+  { if (*p == '\n') n++;
+    else if (*p != ' ' && *p != '\t') break;
+  }
+  *lines += n;
+  return p;
+}
+
+const char * skipComment( const char * p, const char * end, int * lines )
+{ int n = 0;
+#ifdef VLEN
+  vec star = vsplat('*'), slash = vsplat('/'), nl = vsplat('\n');
+  while (end - p > VLEN)
+  { vec v = vload(p);
+    unsigned int m = vmask(veq(v,nl));
+    unsigned int c = vmask(vand(veq(v,star),veq(vload(p+1),slash)));
+    if (c != 0)
+    { int i = __builtin_ctz(c);
+      *lines += n + __builtin_popcount(BELOW(m,i));
+      return p + i;
+    }
+    n += __builtin_popcount(m);
+    p += VLEN;
+  }
+#endif
+  for (; p + 1 < end; p++)
+  { if (p[0] == '*' && p[1] == '/')
+    { *lines += n;
+      return p;
+    }
+    if (*p == '\n') n++;
+  }
+  if (p < end && *p != '*')
+  { if (*p == '\n') n++;
+    p++;
+  }
+  *lines += n;
+  return p;
+}
+
+int countNewlines( const char * p, const char * end )
+{ int n = 0;
+#ifdef VLEN
+  vec nl = vsplat('\n');
+  for (; end - p >= VLEN; p += VLEN)
+    n += __builtin_popcount(vmask(veq(vload(p),nl)));
+#endif
+  for (; p < end; p++)
+    if (*p == '\n') n++;
+  return n;
+}
@@ -0,0 +1,29 @@
+/****************************************************/
+/* File: skip.h                                     */
+/* Bulk skipping of blanks and comment text for     */
+/* the C-minus scanners (SSE2/AVX2 when available)  */
+/****************************************************/
+
+#ifndef _SKIP_H_
+#define _SKIP_H_
+
+/* Function skipBlanks returns the first character
+ * in [p,end) that is not a blank, tab or newline
+ * (or end), adding the newlines passed to *lines
+ */
+const char * skipBlanks( const char * p, const char * end, int * lines );
+
+/* Function skipComment returns the '*' of the first
+ * "*" "/" pair in [p,end), adding the newlines passed
+ * to *lines. If there is none it returns end, or
+ * end-1 when the last character is a '*' that may
+ * start a pair continued past end
+ */
+const char * skipComment( const char * p, const char * end, int * lines );
+
+/* Function countNewlines returns the number of
+ * newlines in [p,end)
+ */
+int countNewlines( const char * p, const char * end );
+
+#endif
@@ -9,75 +9,49 @@
 #include "globals.h"
 #include "symtab.h"
 #include "analyze.h"
+#include "intern.h"
+#include "lines.h"
+#include "util.h"
 
 /* counter for variable memory locations */
 static int location = 0;
 static char* funcName = NULL;
 static int isForFunc = FALSE;
+/* TRUE while in a function declaration that was
+ * rejected, whose parameters are not inserted
+ */
+static int funcRejected = FALSE;
 static char* tempName = NULL;
 static BucketList tempBucket = NULL;
 extern ScopeList currentScope;
 extern ScopeList globalScope;
 static int compNum = 0;
-/* Procedure traverse is a generic recursive 
- * syntax tree traversal routine:
- * it applies preProc in preorder and postProc 
- * in postorder to tree pointed to by t
- */
-static void traverse( TreeNode * t,
-               void (* preProc) (TreeNode *),
-               void (* postProc) (TreeNode *) )
-{ if (t != NULL)
-  { preProc(t);
-    { int i;
-      for (i=0; i < MAXCHILDREN; i++){
-        traverse(t->child[i],preProc,postProc);
-      }
-    }
-    postProc(t);
-    traverse(t->sibling,preProc,postProc);
-  }
-}
-
-/* nullProc is a do-nothing procedure to 
- * generate preorder-only or postorder-only
- * traversals from traverse
- */
-static void nullProc(TreeNode * t)
-{ if (t==NULL) return;
-  else return;
-}
-
 
 static void insertIOFunc(void){ 
-   st_insert(globalScope, "output", Void, 0, 0, TRUE); 
+   st_insert(globalScope, intern("output",6), Void, 0, 0, TRUE); 
    globalScope->location++;
-   BucketList output = st_lookat(globalScope, "output");
-   output->params[0] = Integer;
-   output->paramNumber++;
-   st_insert(globalScope, "input", Integer, 0, 1, TRUE); 
+   insertFuncParam(intern("output",6), Integer);
+   st_insert(globalScope, intern("input",5), Integer, 0, 1, TRUE); 
 }
 /* Procedure insertNode inserts 
  * identifiers stored in t into 
  * the symbol table 
  */
-static void insertNode( TreeNode * t)
-{ switch (t->nodekind)
+static void insertNode( Tree t)
+{ switch (NODEKIND(t))
   { case StmtK:
-      switch (t->kind.stmt)
+      switch (STMTKIND(t))
       { case CompK:
-          if(isForFunc){ /*func compound*/
-            t->attr.name = funcName;
+          if(isForFunc){ /*func compound, in the scope made for the function*/
+            ATTR(t).scope = currentScope;
             isForFunc = FALSE;
           }
-          else{ /*new compound*/
-            char t_name = compNum + 48;
-            char* temp_name = malloc(2*sizeof(char));
-            temp_name[0] = t_name;
-            temp_name[1] = '\0';
-            ScopeList newScope = create_scope(temp_name);
+          else{ /*new compound, named by its number*/
+            char t_name[12];
+            int len = sprintf(t_name, "%d", compNum);
+            ScopeList newScope = create_scope(intern(t_name, len));
             compNum++;
-            t->attr.name = temp_name;
+            ATTR(t).scope = newScope;
             currentScope = newScope;
           }
           break;
@@ -86,18 +60,18 @@ static void insertNode( TreeNode * t)
       }
       break;
     case ExpK:
-      switch (t->kind.exp)
+      switch (EXPKIND(t))
       { case IdK:
         case ArrIdK:
         case CallK:
-          tempName = t->attr.name;
+          tempName = ATTR(t).name;
           tempBucket = st_lookup(currentScope, tempName);
           if(tempBucket == NULL){ /*error*/
-            fprintf(listing, "Error at line(%d), name=%s : This Variable is not declared before!! \n", t->lineno, t->attr.name);
+            fprintf(listing, "Error at line(%d), name=%s : This Variable is not declared before!! \n", lineOf(POS(t)), ATTR(t).name);
             break;
           }
           else{
-            add_line(tempBucket ,t->lineno); 
+            add_line(tempBucket ,lineOf(POS(t))); 
           }
           tempName = NULL;
           tempBucket = NULL;
@@ -107,58 +81,60 @@ static void insertNode( TreeNode * t)
       }
       break;
     case DeclK:
-      switch(t->kind.decl)
+      switch(DECLKIND(t))
       { case FuncK:
-          funcName = t->attr.name;
+          funcName = ATTR(t).name;
+          funcRejected = TRUE;
           if(st_lookat(globalScope, funcName)){
-            fprintf(listing, "Error at line(%d), name=%s : Function Redeclaration Error!!\n", t->lineno, funcName);
+            fprintf(listing, "Error at line(%d), name=%s : Function Redeclaration Error!!\n", lineOf(POS(t)), funcName);
             break;
           }
           if(currentScope != globalScope){
-            fprintf(listing, "Error at line(%d), name=%s : Function Declaration only in global!!\n", t->lineno, funcName);
+            fprintf(listing, "Error at line(%d), name=%s : Function Declaration only in global!!\n", lineOf(POS(t)), funcName);
             break;
           }
+          funcRejected = FALSE;
           isForFunc = TRUE;
           ScopeList newScope = create_scope(funcName);
           ExpType type_t;
-          if(t->child[0]->attr.type == INT){
+          if(ATTR(CHILD(t,0)).type == INT){
              type_t= Integer;
-             t->type = Integer;
+             EXPTYPE(t) = Integer;
           }
-          else if(t->child[0]->attr.type == VOID){
+          else if(ATTR(CHILD(t,0)).type == VOID){
             type_t = Void;
-            t->type = Void;
+            EXPTYPE(t) = Void;
           }
           else{
             type_t = Void;
-            t->type = Void;
+            EXPTYPE(t) = Void;
           }
-          st_insert(currentScope, funcName, type_t, t->lineno, currentScope->location, 1);
+          st_insert(currentScope, funcName, type_t, lineOf(POS(t)), currentScope->location, 1);
           currentScope->location++;
           currentScope = newScope;
           break;
         case VarK:
-          tempName = t->attr.name;
+          tempName = ATTR(t).name;
           if(st_lookat(currentScope, tempName) == NULL){
-              t->type = Integer;
-              st_insert(currentScope, tempName, Integer, t->lineno, currentScope->location, 0);
+              EXPTYPE(t) = Integer;
+              st_insert(currentScope, tempName, Integer, lineOf(POS(t)), currentScope->location, 0);
               currentScope->location++;
           }
           else{
-            fprintf(listing, "Error at line(%d), name=(%s) : Variable Redeclaration Error!!\n", t->lineno, t->attr.name);
+            fprintf(listing, "Error at line(%d), name=(%s) : Variable Redeclaration Error!!\n", lineOf(POS(t)), ATTR(t).name);
             break;
           }
           tempName = NULL;
           break;
         case ArrVarK:
-          tempName = t->attr.arr.name;
+          tempName = ARRNAME(t);
           if(st_lookat(currentScope, tempName) == NULL){
-              t->type = IntegerArray;
-              st_insert(currentScope, tempName, IntegerArray, t->lineno, currentScope->location, 0);
+              EXPTYPE(t) = IntegerArray;
+              st_insert(currentScope, tempName, IntegerArray, lineOf(POS(t)), currentScope->location, 0);
               currentScope->location++;
           }
           else{
-            fprintf(listing, "Error at line(%d), name=(%s) : ArrayVariable Redeclaration Error!!\n", t->lineno, tempName);
+            fprintf(listing, "Error at line(%d), name=(%s) : ArrayVariable Redeclaration Error!!\n", lineOf(POS(t)), tempName);
             break;
           }
           tempName = NULL;
@@ -170,26 +146,26 @@ static void insertNode( TreeNode * t)
       break;
 
     case ParamK:
-        if(t->child[0]->attr.type == VOID){
+        if(funcRejected || ATTR(CHILD(t,0)).type == VOID){
             break;
         }
 
-        if(st_lookat(currentScope, t->attr.name) == NULL){
+        if(st_lookat(currentScope, ATTR(t).name) == NULL){
             ExpType temp;
-            if(t->kind.param == NonArrParamK){
+            if(PARAMKIND(t) == NonArrParamK){
                 temp = Integer;
-                t->type = Integer;
+                EXPTYPE(t) = Integer;
             }
             else{
                 temp = IntegerArray;
-                t->type = IntegerArray;
+                EXPTYPE(t) = IntegerArray;
             }
-            st_insert(currentScope, t->attr.name, temp, t->lineno, currentScope->location, 0);
+            st_insert(currentScope, ATTR(t).name, temp, lineOf(POS(t)), currentScope->location, 0);
             insertFuncParam(currentScope->name, temp);
             currentScope->location++;
         }
         else{ /*Error*/
-            fprintf(listing, "Error at line(%d), name=(%s): Parameter Redeclaration Error!!\n", t->lineno, t->attr.name);
+            fprintf(listing, "Error at line(%d), name=(%s): Parameter Redeclaration Error!!\n", lineOf(POS(t)), ATTR(t).name);
         }
       break;
 
@@ -198,28 +174,36 @@ static void insertNode( TreeNode * t)
   }
 }
 
-static void afterInsertNode(TreeNode* t){
-    if(t->nodekind == StmtK && t->kind.stmt == CompK){
+static void afterInsertNode(Tree t){
+    if(NODEKIND(t) == StmtK && STMTKIND(t) == CompK){
         currentScope = currentScope->parent;
     }
 }
 
-/* Function buildSymtab constructs the symbol 
- * table by preorder traversal of the syntax tree
+/* startSymtab makes the global scope, with the
+ * input and output functions, the first time
  */
-void buildSymtab(TreeNode * syntaxTree)
-{ globalScope = create_scope("global");
+static void startSymtab(void)
+{ if (globalScope != NULL) return;
+  globalScope = create_scope(intern("global",6));
   currentScope = globalScope;
   insertIOFunc();
-  traverse(syntaxTree,insertNode,afterInsertNode);
+}
+
+/* Function buildSymtab constructs the symbol 
+ * table by preorder traversal of the syntax tree
+ */
+void buildSymtab(Tree syntaxTree)
+{ startSymtab();
+  walkTree(syntaxTree,insertNode,afterInsertNode);
   /*if (TraceAnalyze)
   { fprintf(listing,"\nSymbol table:\n\n");
     printSymTab(listing);
   }*/
 }
 
-static void typeError(TreeNode * t, char * message)
-{ fprintf(listing,"Type error at line %d: %s\n",t->lineno,message);
+static void typeError(Tree t, char * message)
+{ fprintf(listing,"Type error at line %d: %s\n",lineOf(POS(t)),message);
   Error = TRUE;
 }
 
@@ -227,25 +211,22 @@ static void typeError(TreeNode * t, char * message)
  * type checking at a single tree node
  */
 
-static void beforeCheckNode(TreeNode* t){
-   switch(t->nodekind){
+static void beforeCheckNode(Tree t){
+   switch(NODEKIND(t)){
        case DeclK:
-           switch(t->kind.decl){
+           switch(DECLKIND(t)){
                case FuncK:
-                 funcName = t->attr.name;
+                 funcName = ATTR(t).name;
                  break;
                default:
                  break;
            }
            break;
        case StmtK:
-           switch(t->kind.stmt){
+           switch(STMTKIND(t)){
                case CompK:
-               {
-                 ScopeList scope = find_scope(t->attr.name);
-                 currentScope = scope;
+                 currentScope = ATTR(t).scope;
                  break;
-               }
                default:
                  break;
            }
@@ -255,131 +236,147 @@ static void beforeCheckNode(TreeNode* t){
    }
 }
 
-static void checkNode(TreeNode * t)
+/* typeOf returns the type checked for the
+ * expression t; a shared IdK (see HASH_CONS) keeps
+ * none, as its uses may be in different scopes, so
+ * its name is looked up in the current one
+ */
+static ExpType typeOf(Tree t)
+{
+#if HASH_CONS
+  if (NODEKIND(t) == ExpK && EXPKIND(t) == IdK)
+  { BucketList id = st_lookup(currentScope, ATTR(t).name);
+    return id == NULL ? Void : id->type;
+  }
+#endif
+  return EXPTYPE(t);
+}
+
+static void checkNode(Tree t)
 {
-  switch (t->nodekind)
+  switch (NODEKIND(t))
   { case ExpK:
-      switch (t->kind.exp)
+      switch (EXPKIND(t))
       { case AssignK:
           {//var but type is void
           //fprintf(listing, "AssignK\n");
           ExpType lhsType;
           ExpType rhsType;
           //fprintf(listing, "AssignK\n");
-          if(t->child[0]->kind.exp != ConstK && t->child[0]->kind.exp != OpK && t->child[0]->kind.exp != CallK){
-            BucketList lhs = st_lookup(currentScope, t->child[0]->attr.name);
+          if(EXPKIND(CHILD(t,0)) != ConstK && EXPKIND(CHILD(t,0)) != OpK && EXPKIND(CHILD(t,0)) != CallK){
+            BucketList lhs = st_lookup(currentScope, ATTR(CHILD(t,0)).name);
             if(lhs->type == IntegerArray){
-                lhsType = t->child[0]->type;
+                lhsType = typeOf(CHILD(t,0));
             }
             else{
                 lhsType = lhs->type;
             }
           }
           else
-              lhsType = t->child[0]->type;
+              lhsType = typeOf(CHILD(t,0));
           //fprintf(listing, "AssignK\n");
-          if(t->child[1]->kind.exp != ConstK && t->child[1]->kind.exp != OpK && t->child[1]->kind.exp != CallK){
-            BucketList rhs = st_lookup(currentScope, t->child[1]->attr.name);
+          if(EXPKIND(CHILD(t,1)) != ConstK && EXPKIND(CHILD(t,1)) != OpK && EXPKIND(CHILD(t,1)) != CallK){
+            BucketList rhs = st_lookup(currentScope, ATTR(CHILD(t,1)).name);
             if(rhs->type == IntegerArray){
-                rhsType = t->child[1]->type;
+                rhsType = typeOf(CHILD(t,1));
             }
             else{
                 rhsType = rhs->type;
             }
           }
           else
-              rhsType = t->child[1]->type;
+              rhsType = typeOf(CHILD(t,1));
 
           //fprintf(listing, "AssignK\n");
           if(lhsType == Void || rhsType == Void){
-            fprintf(listing, "ERROR at line(%d) : Variable type cannot be Void\n", t->lineno);
+            fprintf(listing, "ERROR at line(%d) : Variable type cannot be Void\n", lineOf(POS(t)));
           }
           // integer array but type is void
           else if(lhsType == IntegerArray && rhsType == Integer){
-            fprintf(listing, "ERROR at line(%d) : Variable type does not match\n", t->lineno);
+            fprintf(listing, "ERROR at line(%d) : Variable type does not match\n", lineOf(POS(t)));
           }
           else if(lhsType == Integer && rhsType == IntegerArray){
-            fprintf(listing, "ERROR at line(%d) : Variable type does not match\n", t->lineno);
+            fprintf(listing, "ERROR at line(%d) : Variable type does not match\n", lineOf(POS(t)));
           }
           else
-              t->type = lhsType;
+              EXPTYPE(t) = lhsType;
           }
           break;
         case OpK:
           //fprintf(listing, "OpK\n");
-          { TreeNode* left = t->child[0];
-            TreeNode* right = t->child[1];
-            if(left->type == Void || right->type == Void){
-                fprintf(listing, "ERROR at line(%d): Operand type cannot be Void\n", t->lineno);
+          { Tree left = CHILD(t,0);
+            Tree right = CHILD(t,1);
+            if(typeOf(left) == Void || typeOf(right) == Void){
+                fprintf(listing, "ERROR at line(%d): Operand type cannot be Void\n", lineOf(POS(t)));
                 break;
             }
-            ExpType leftType = left->type;
-            ExpType rightType = right->type;
-            if(left->type == IntegerArray && left->child[0] != NULL){
+            ExpType leftType = typeOf(left);
+            ExpType rightType = typeOf(right);
+            if(typeOf(left) == IntegerArray && CHILD(left,0) != NOTREE){
                 // Element of Array
                 leftType = Integer;
             }
-            if(right->type == IntegerArray && right->child[0] != NULL){
+            if(typeOf(right) == IntegerArray && CHILD(right,0) != NOTREE){
                 // Element of Array
                 rightType = Integer;
             }
 
             if(leftType != rightType){
-                fprintf(listing, "ERROR at line(%d) : Operand Type does not match\n", t->lineno);
+                fprintf(listing, "ERROR at line(%d) : Operand Type does not match\n", lineOf(POS(t)));
                 break;
             }
-            t->type = Integer;
+            EXPTYPE(t) = Integer;
           }
           break;
         case ConstK:
-          t->type = Integer;
+          EXPTYPE(t) = Integer;
           break;
         case IdK:
           //fprintf(listing, "IdK\n");
-          { BucketList id = st_lookup(currentScope, t->attr.name);
+          { BucketList id = st_lookup(currentScope, ATTR(t).name);
             if(id == NULL){
-                fprintf(listing, "ERROR at line(%d): Variable is not declared before\n", t->lineno);
+                fprintf(listing, "ERROR at line(%d): Variable is not declared before\n", lineOf(POS(t)));
                 break;
             }
-            t->type = id->type; 
+            EXPTYPE(t) = id->type; 
           }
           break;
         case ArrIdK:
           //fprintf(listing, "ArrIdK\n");
-          { BucketList arrId = st_lookup(currentScope, t->attr.name);
+          { BucketList arrId = st_lookup(currentScope, ATTR(t).name);
             if(arrId == NULL){
-                fprintf(listing, "ERROR at line(%d): Variable is not declared before\n", t->lineno);
+                fprintf(listing, "ERROR at line(%d): Variable is not declared before\n", lineOf(POS(t)));
                 break;
             }
-            if(t->child[0] == NULL) // array
-                t->type = IntegerArray;
+            if(CHILD(t,0) == NOTREE) // array
+                EXPTYPE(t) = IntegerArray;
             else{ //element of arr
-                t->type = Integer;
+                EXPTYPE(t) = Integer;
             }
           }
           break;
         case CallK:
-          { BucketList func = st_lookat(globalScope, t->attr.name);
+          { BucketList func = st_lookat(globalScope, ATTR(t).name);
             if(func == NULL){
-                fprintf(listing, "ERROR at line(%d) : Function not declared before", t->lineno);
+                fprintf(listing, "ERROR at line(%d) : Function not declared before", lineOf(POS(t)));
                 break;
             }
             int argCnt = 0;
-            TreeNode* arg = t->child[0];
+            Tree arg = CHILD(t,0);
             int cntError = 0;
-            while(arg != NULL){
+            while(arg != NOTREE){
                 ExpType argType;
-                if(arg->nodekind == ExpK && (arg->kind.exp == OpK || arg->kind.exp == ConstK)){
-                    argType = arg->type;
+                if(NODEKIND(arg) == ExpK && (EXPKIND(arg) == OpK || EXPKIND(arg) == ConstK)){
+                    argType = typeOf(arg);
                 }
                 else{
-                    BucketList argBucket = st_lookup(currentScope, arg->attr.name);
+                    BucketList argBucket = st_lookup(currentScope, ATTR(arg).name);
                     if(argBucket == NULL){
-                        fprintf(listing, "ERROR at line(%d) : Argument does not declared before\n", t->lineno);
+                        fprintf(listing, "ERROR at line(%d) : Argument does not declared before\n", lineOf(POS(t)));
                         break;
                     }
                     if(argBucket->type == IntegerArray){
-                        argType = arg->type;
+                        argType = typeOf(arg);
                     }
                     else{
                         argType = argBucket->type;
@@ -392,25 +389,25 @@ static void checkNode(TreeNode * t)
                 else
                     fprintf(listing, "argType is Void\n");*/
 
-                if(argType != func->params[argCnt]){
-                    fprintf(listing, "ERROR at line(%d) : Argument type does not match\n", t->lineno);
+                if(argType != (argCnt < func->paramNumber ? func->params[argCnt] : Void)){
+                    fprintf(listing, "ERROR at line(%d) : Argument type does not match\n", lineOf(POS(t)));
                     break;
                 }
                 argCnt++;
-                arg = arg->sibling;
-                if(argCnt >= func->paramNumber && arg != NULL){
-                    fprintf(listing, "ERROR at line(%d) : Argument Count does not match\n", t->lineno);
+                arg = SIBLING(arg);
+                if(argCnt >= func->paramNumber && arg != NOTREE){
+                    fprintf(listing, "ERROR at line(%d) : Argument Count does not match\n", lineOf(POS(t)));
                     cntError = 1;
                     break;
                 }
             }
             if(cntError == 0){
                 if(argCnt != func->paramNumber){
-                    fprintf(listing, "ERROR at line(%d) : Argument Count does not match\n", t->lineno);
+                    fprintf(listing, "ERROR at line(%d) : Argument Count does not match\n", lineOf(POS(t)));
                     break;
                 }
                 else{
-                    t->type = func->type;
+                    EXPTYPE(t) = func->type;
                 }
             }
           }
@@ -421,34 +418,34 @@ static void checkNode(TreeNode * t)
       break;
     case StmtK:
           //fprintf(listing, "StmtK\n");
-      switch (t->kind.stmt)
+      switch (STMTKIND(t))
       {case IfK:
-          if(t->child[0] == NULL){
-            fprintf(listing, "ERROR at line(%d) : Conditional Expression is needed\n", t->lineno);
+          if(CHILD(t,0) == NOTREE){
+            fprintf(listing, "ERROR at line(%d) : Conditional Expression is needed\n", lineOf(POS(t)));
             break;
           }
-          if(t->child[0]->type == Void){
-            fprintf(listing, "ERROR at line(%d) : Conditional Expression cannot be VOID\n", t->lineno);
+          if(typeOf(CHILD(t,0)) == Void){
+            fprintf(listing, "ERROR at line(%d) : Conditional Expression cannot be VOID\n", lineOf(POS(t)));
             break;
           }
           break;
         case IfEK:
-          if(t->child[0] == NULL){
-            fprintf(listing, "ERROR at line(%d) : If Conditional Expression is need\n", t->lineno);
+          if(CHILD(t,0) == NOTREE){
+            fprintf(listing, "ERROR at line(%d) : If Conditional Expression is need\n", lineOf(POS(t)));
             break;
           }
-          if(t->child[0]->type == Void){
-            fprintf(listing, "ERROR at line(%d) : If Conditional Expression cannot be VOID\n", t->lineno);
+          if(typeOf(CHILD(t,0)) == Void){
+            fprintf(listing, "ERROR at line(%d) : If Conditional Expression cannot be VOID\n", lineOf(POS(t)));
             break;
           }
           break;
         case IterK:
-          if(t->child[0] == NULL){
-            fprintf(listing, "ERROR at line(%d) : LOOP Conditional Expression is need\n", t->lineno);
+          if(CHILD(t,0) == NOTREE){
+            fprintf(listing, "ERROR at line(%d) : LOOP Conditional Expression is need\n", lineOf(POS(t)));
             break;
           }
-          if(t->child[0]->type == Void){
-            fprintf(listing, "ERROR at line(%d) : LOOP Conditional Expression cannot be VOID\n", t->lineno);
+          if(typeOf(CHILD(t,0)) == Void){
+            fprintf(listing, "ERROR at line(%d) : LOOP Conditional Expression cannot be VOID\n", lineOf(POS(t)));
             break;
           }
           break;
@@ -462,30 +459,30 @@ static void checkNode(TreeNode * t)
           {
           BucketList func = st_lookat(globalScope, funcName);
           if(func->type == Void){
-            if(t->child[0] != NULL){
-                fprintf(listing, "ERROR at line(%d) : Should Return Nothing Error\n", t->lineno);
+            if(CHILD(t,0) != NOTREE){
+                fprintf(listing, "ERROR at line(%d) : Should Return Nothing Error\n", lineOf(POS(t)));
             }
           }
           else{ //type matching
-              if(t->child[0] == NULL){
-                    fprintf(listing, "ERROR at line(%d) : Should Return Something Error\n", t->lineno); 
+              if(CHILD(t,0) == NOTREE){
+                    fprintf(listing, "ERROR at line(%d) : Should Return Something Error\n", lineOf(POS(t))); 
               }
               else{
-                if(t->child[0]->nodekind == ExpK && t->child[0]->kind.exp == ConstK){
+                if(NODEKIND(CHILD(t,0)) == ExpK && EXPKIND(CHILD(t,0)) == ConstK){
                     if(func->type != Integer)
-                        fprintf(listing, "ERROR at line(%d) : Function type and Return type Does not match\n", t->lineno);
+                        fprintf(listing, "ERROR at line(%d) : Function type and Return type Does not match\n", lineOf(POS(t)));
                 }
                 else{
-                    if(t->child[0]->kind.exp == CallK){
-                        char* callFunc = t->child[0]->attr.name;
+                    if(EXPKIND(CHILD(t,0)) == CallK){
+                        char* callFunc = ATTR(CHILD(t,0)).name;
                         BucketList bucketFunc = st_lookat(globalScope, callFunc);
                         if(func->type != bucketFunc->type){
-                            fprintf(listing, "ERROR at line(%d) : Function type and Return type Does not match\n", t->lineno);
+                            fprintf(listing, "ERROR at line(%d) : Function type and Return type Does not match\n", lineOf(POS(t)));
                         }
                     }
                     else{
-                        if(func->type != t->child[0]->type){
-                            fprintf(listing, "ERROR at line(%d) : Function type and Return type Does not match\n", t->lineno);
+                        if(func->type != typeOf(CHILD(t,0))){
+                            fprintf(listing, "ERROR at line(%d) : Function type and Return type Does not match\n", lineOf(POS(t)));
                         }
                     }
                 }
@@ -498,23 +495,23 @@ static void checkNode(TreeNode * t)
       }
       break;
     case DeclK:
-      switch(t->kind.decl){
+      switch(DECLKIND(t)){
           case VarK:
-              if(t->child[0] == NULL){
-                fprintf(listing, "ERROR at line(%d), name(%s) : Variable type cannot be NULL\n", t->lineno, t->attr.name);
+              if(CHILD(t,0) == NOTREE){
+                fprintf(listing, "ERROR at line(%d), name(%s) : Variable type cannot be NULL\n", lineOf(POS(t)), ATTR(t).name);
                 break;
               }
-              if(t->child[0]->attr.type == VOID){
-                  fprintf(listing, "ERROR at line(%d), name=%s : Variable type cannot be Void\n", t->lineno, t->attr.name);
+              if(ATTR(CHILD(t,0)).type == VOID){
+                  fprintf(listing, "ERROR at line(%d), name=%s : Variable type cannot be Void\n", lineOf(POS(t)), ATTR(t).name);
               }
               break;
           case ArrVarK:
-              if(t->child[0] == NULL){
-                fprintf(listing, "ERROR at line(%d), name(%s) : Variable type cannot be NULL\n", t->lineno, t->attr.arr.name);
+              if(CHILD(t,0) == NOTREE){
+                fprintf(listing, "ERROR at line(%d), name(%s) : Variable type cannot be NULL\n", lineOf(POS(t)), ARRNAME(t));
                 break;
               }
-              if(t->child[0]->attr.type == VOID){
-                  fprintf(listing, "ERROR at line(%d), name=%s : Variable type cannot be Void\n", t->lineno, t->attr.arr.name);
+              if(ATTR(CHILD(t,0)).type == VOID){
+                  fprintf(listing, "ERROR at line(%d), name=%s : Variable type cannot be Void\n", lineOf(POS(t)), ARRNAME(t));
               }
               break;
       }
@@ -531,6 +528,18 @@ static void checkNode(TreeNode * t)
 /* Procedure typeCheck performs type checking 
  * by a postorder syntax tree traversal
  */
-void typeCheck(TreeNode * syntaxTree)
-{ traverse(syntaxTree,beforeCheckNode,checkNode);
+void typeCheck(Tree syntaxTree)
+{ walkTree(syntaxTree,beforeCheckNode,checkNode);
+}
+
+/* Procedure analyzeDecl enters a top-level
+ * declaration into the symbol table and type
+ * checks it; the scopes of a function are done
+ * with once it has been checked
+ */
+void analyzeDecl(Tree decl)
+{ startSymtab();
+  walkTree(decl,insertNode,afterInsertNode);
+  walkTree(decl,beforeCheckNode,checkNode);
+  release_scopes();
 }
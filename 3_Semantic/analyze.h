@@ -11,11 +11,22 @@
 /* Function buildSymtab constructs the symbol 
  * table by preorder traversal of the syntax tree
  */
-void buildSymtab(TreeNode *);
+void buildSymtab(Tree);
 
 /* Procedure typeCheck performs type checking 
  * by a postorder syntax tree traversal
  */
-void typeCheck(TreeNode *);
+void typeCheck(Tree);
+
+/* Procedure analyzeDecl builds the symbol table
+ * entries of one top-level declaration and type
+ * checks it, as soon as it has been parsed; only
+ * the global scope is kept afterwards, the rows of
+ * the others being kept for printSymTab. Names are
+ * looked up among the declarations analyzed so far.
+ * buildSymtab and typeCheck add nothing to the
+ * table afterwards if given no tree
+ */
+void analyzeDecl(Tree);
 
 #endif
@@ -0,0 +1,77 @@
+/****************************************************/
+/* File: arena.c                                    */
+/* Bump allocation for the C-minus compiler         */
+/* Chunks are malloc'd CHUNKSIZE bytes at a time;   */
+/* a request too large for a chunk gets one of its  */
+/* own, so the space left in the current chunk is   */
+/* not wasted                                       */
+/****************************************************/
+
+#include <stdlib.h>
+#include <stddef.h>
+#include "arena.h"
+
+/* bytes in an ordinary chunk */
+#define CHUNKSIZE (64*1024)
+
+/* the alignment of allocations */
+typedef union { long l; double d; void * p; } Align;
+#define ALIGN(n) (((n) + sizeof(Align) - 1) & ~(sizeof(Align) - 1))
+
+typedef struct ArenaChunk
+   { struct ArenaChunk * next;
+     Align data[1]; /* the rest of the chunk */
+   } ArenaChunk;
+
+void * arenaAlloc( Arena * a, unsigned int size )
+{ ArenaChunk * c;
+  void * p;
+  size = ALIGN(size);
+  if (size <= a->end - a->next)
+  { p = a->next;
+    a->next += size;
+    return p;
+  }
+  if (size > CHUNKSIZE/4) /* on its own, behind the current chunk */
+  { c = malloc(offsetof(ArenaChunk,data) + size);
+    if (c == NULL) return NULL;
+    if (a->chunks == NULL)
+    { c->next = NULL;
+      a->chunks = c;
+    }
+    else
+    { c->next = a->chunks->next;
+      a->chunks->next = c;
+    }
+    return c->data;
+  }
+  c = malloc(offsetof(ArenaChunk,data) + CHUNKSIZE);
+  if (c == NULL) return NULL;
+  c->next = a->chunks;
+  a->chunks = c;
+  a->next = (char *) c->data + size;
+  a->end = (char *) c->data + CHUNKSIZE;
+  return c->data;
+}
+
+void arenaRelease( Arena * a )
+{ while (a->chunks != NULL)
+  { ArenaChunk * c = a->chunks;
+    a->chunks = c->next;
+    free(c);
+  }
+  a->next = a->end = NULL;
+}
+
+void arenaMerge( Arena * a, Arena * b )
+{ ArenaChunk * c = b->chunks;
+  if (c == NULL) return;
+  if (a->chunks == NULL) *a = *b;
+  else /* behind the current chunk of a */
+  { while (c->next != NULL) c = c->next;
+    c->next = a->chunks->next;
+    a->chunks->next = b->chunks;
+  }
+  b->chunks = NULL;
+  b->next = b->end = NULL;
+}
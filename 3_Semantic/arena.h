@@ -0,0 +1,41 @@
+/****************************************************/
+/* File: arena.h                                    */
+/* Bump allocation for the C-minus compiler: the    */
+/* syntax tree and the identifier names live in     */
+/* arenas that are released all at once at the end  */
+/* of a compilation                                 */
+/****************************************************/
+
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+struct ArenaChunk;
+
+/* an Arena is a list of chunks, the current one
+ * being filled from next up to end; an Arena is
+ * used by one thread at a time, and an all zero
+ * Arena is empty
+ */
+typedef struct
+   { struct ArenaChunk * chunks;
+     char * next;
+     char * end;
+   } Arena;
+
+/* Function arenaAlloc returns size bytes from a,
+ * aligned for any type, or NULL if out of memory
+ */
+void * arenaAlloc( Arena * a, unsigned int size );
+
+/* Procedure arenaRelease frees everything that was
+ * allocated from a, leaving it empty for reuse
+ */
+void arenaRelease( Arena * a );
+
+/* Procedure arenaMerge moves everything that was
+ * allocated from b into a, leaving b empty; it is
+ * then released with a
+ */
+void arenaMerge( Arena * a, Arena * b );
+
+#endif
@@ -0,0 +1,151 @@
+/****************************************************/
+/* File: ast.c                                      */
+/* Storage of the compact syntax tree               */
+/* Nodes and child slots are kept in two arrays     */
+/* that double when full, so a tree takes a few     */
+/* large blocks; node 0 stands for NOTREE, and has  */
+/* slots of its own so that a failed astNew does    */
+/* not make the parser write out of bounds. Each    */
+/* thread has arrays of its own, which astJoin      */
+/* renumbers into another thread's                  */
+/****************************************************/
+
+#include "globals.h"
+
+#if COMPACT_AST
+
+#include "ast.h"
+
+/* initial sizes of the arrays */
+#define INITNODES 1024
+#define INITKIDS 2048
+
+__thread AstNode * astNode = NULL;
+__thread Tree * astKids = NULL;
+
+static __thread unsigned int nodeCount = 0, nodeCap = 0;
+static __thread unsigned int kidCount = 0, kidCap = 0;
+
+/* the number of child slots by node kind and kind;
+ * it is one more than the children of an ArrVarK,
+ * to hold its size
+ */
+static const unsigned char slots[5][6] =
+   { /* StmtK: IfK,IfEK,CompK,IterK,RetK */ {2,3,2,2,1},
+     /* ExpK: AssignK,OpK,ConstK,IdK,ArrIdK,CallK */ {2,2,0,0,1,1},
+     /* DeclK: VarK,FuncK,ArrVarK */ {1,3,2},
+     /* ParamK: ArrParamK,NonArrParamK */ {1,1},
+     /* TypeK: TypeNameK */ {0} };
+
+/* grow doubles the array at *a of *cap elements of
+ * size bytes until it holds need elements
+ */
+static int grow(void ** a, unsigned int * cap, unsigned int need, int size)
+{ unsigned int n = *cap;
+  void * p;
+  while (n < need) n *= 2;
+  p = realloc(*a,(size_t) n * size);
+  if (p == NULL) return FALSE;
+  *a = p;
+  *cap = n;
+  return TRUE;
+}
+
+/* start sets up the arrays with node 0, NOTREE,
+ * unless they are set up already
+ */
+static int start(void)
+{ if (astNode != NULL) return TRUE;
+  astNode = malloc(INITNODES * sizeof(AstNode));
+  astKids = malloc(INITKIDS * sizeof(Tree));
+  if (astNode == NULL || astKids == NULL) return FALSE;
+  nodeCap = INITNODES;
+  kidCap = INITKIDS;
+  memset(&astNode[0],0,sizeof(AstNode));
+  memset(astKids,0,MAXCHILDREN * sizeof(Tree));
+  nodeCount = 1;
+  kidCount = MAXCHILDREN;
+  return TRUE;
+}
+
+Tree astNew( NodeKind nodekind, int kind )
+{ int n = slots[nodekind][kind];
+  AstNode * t;
+  if (!start()) return NOTREE;
+  if ((nodeCount == nodeCap &&
+       !grow((void **) &astNode,&nodeCap,nodeCount+1,sizeof(AstNode))) ||
+      (kidCount + n > kidCap &&
+       !grow((void **) &astKids,&kidCap,kidCount+n,sizeof(Tree))))
+    return NOTREE;
+  t = &astNode[nodeCount];
+  t->nodekind = nodekind;
+  t->kind = kind;
+  t->type = Void;
+  t->nkids = nodekind == DeclK && kind == ArrVarK ? n-1 : n;
+  t->pos = 0;
+  t->sibling = NOTREE;
+  t->kids = kidCount;
+  memset(&t->attr,0,sizeof(t->attr));
+  memset(&astKids[kidCount],0,n * sizeof(Tree));
+  kidCount += n;
+  return nodeCount++;
+}
+
+void astRelease( void )
+{ free(astNode);
+  free(astKids);
+  astNode = NULL;
+  astKids = NULL;
+  nodeCount = nodeCap = kidCount = kidCap = 0;
+}
+
+void astTake( AstPart * part )
+{ part->node = astNode;
+  part->kids = astKids;
+  part->nodeCount = nodeCount;
+  part->kidCount = kidCount;
+  astNode = NULL;
+  astKids = NULL;
+  nodeCount = nodeCap = kidCount = kidCap = 0;
+}
+
+Tree astJoin( AstPart * part, Tree t )
+{ unsigned int nodes, kids, nodeBase, kidBase, i;
+  if (part->node == NULL) return NOTREE;
+  /* all but node 0 and its slots are copied */
+  nodes = part->nodeCount - 1;
+  kids = part->kidCount - MAXCHILDREN;
+  if (!start() ||
+      (nodeCount + nodes > nodeCap &&
+       !grow((void **) &astNode,&nodeCap,nodeCount+nodes,sizeof(AstNode))) ||
+      (kidCount + kids > kidCap &&
+       !grow((void **) &astKids,&kidCap,kidCount+kids,sizeof(Tree))))
+  { free(part->node);
+    free(part->kids);
+    part->node = NULL;
+    part->kids = NULL;
+    return NOTREE;
+  }
+  nodeBase = nodeCount - 1;
+  kidBase = kidCount - MAXCHILDREN;
+  memcpy(&astNode[nodeCount],&part->node[1],nodes * sizeof(AstNode));
+  memcpy(&astKids[kidCount],&part->kids[MAXCHILDREN],kids * sizeof(Tree));
+  for (i=nodeCount;i<nodeCount+nodes;i++)
+  { AstNode * n = &astNode[i];
+    int j;
+    if (n->sibling != NOTREE) n->sibling += nodeBase;
+    n->kids += kidBase;
+    /* the size slot of an ArrVarK is not a node */
+    for (j=0;j<n->nkids;j++)
+      if (astKids[n->kids+j] != NOTREE) astKids[n->kids+j] += nodeBase;
+  }
+  nodeCount += nodes;
+  kidCount += kids;
+  free(part->node);
+  free(part->kids);
+  part->node = NULL;
+  part->kids = NULL;
+  return t == NOTREE ? NOTREE : t + nodeBase;
+}
+
+#endif
@@ -0,0 +1,46 @@
+/****************************************************/
+/* File: ast.h                                      */
+/* Storage of the compact syntax tree (COMPACT_AST, */
+/* see globals.h) for the C-minus compiler          */
+/****************************************************/
+
+#ifndef _AST_H_
+#define _AST_H_
+
+/* Function astNew appends a node of the given
+ * kinds to astNode, with its child slots set to
+ * NOTREE, and returns it, or NOTREE if out of
+ * memory; astNode and astKids may move
+ */
+Tree astNew( NodeKind nodekind, int kind );
+
+/* Procedure astRelease frees the whole tree */
+void astRelease( void );
+
+#if COMPACT_AST
+
+/* an AstPart holds the arrays of nodes that
+ * another thread has made (see astTake)
+ */
+typedef struct
+   { AstNode * node;
+     Tree * kids;
+     unsigned int nodeCount;
+     unsigned int kidCount;
+   } AstPart;
+
+/* Procedure astTake moves the arrays of the
+ * calling thread into part, leaving it none
+ */
+void astTake( AstPart * part );
+
+/* Function astJoin appends the nodes of part to the
+ * arrays of the calling thread and frees part's;
+ * it returns the node t of part as it is numbered
+ * there, or NOTREE if out of memory
+ */
+Tree astJoin( AstPart * part, Tree t );
+
+#endif
+
+#endif
@@ -11,16 +11,74 @@
 #include "util.h"
 #include "scan.h"
 #include "parse.h"
+#include "intern.h"
+#include "tokens.h"
+#include "lines.h"
+#include "pparse.h"
 
-#define YYSTYPE TreeNode *
-static char * savedName; /* for use in assignments */
-static int savedNumber;
-static int savedLineNo;  /* ditto */
-static TreeNode * savedTree; /* stores syntax tree for later return */
-static int yylex(void); // added 11/2/11 to ensure no conflict with lex
+#define YYSTYPE Tree
+
+/* the state of a parse beyond Bison's own, which is
+ * in ps: tokens are pushed into it (see parse.h)
+ */
+struct ParserRec
+   { struct yypstate * ps;
+     Token tok; /* the last token pushed */
+     char * savedName; /* for use in assignments */
+     int savedNumber;
+     unsigned int savedPos;  /* ditto */
+     Tree savedTree; /* stores syntax tree for later return */
+     char * nullName; /* name of a void parameter list */
+     int status; /* of the last yypush_parse */
+     DeclProc declProc; /* takes the declarations, if set */
+     int muted; /* TRUE if syntax errors are not reported */
+   };
+
+static int yyerror(Parser p, char * message);
+
+/* lists of siblings are built circularly while they
+ * are parsed: a list is kept as its last node, whose
+ * sibling is the first, so that appendList takes
+ * constant time (a shared leaf is copied first, see
+ * ownLeaf); closeList turns the finished list into
+ * the usual one, returning its first node
+ */
+static Tree appendList(Tree last, Tree t)
+{ if (t == NOTREE) return last;
+  t = ownLeaf(t);
+  if (last == NOTREE) SIBLING(t) = t;
+  else
+  { SIBLING(t) = SIBLING(last);
+    SIBLING(last) = t;
+  }
+  return t;
+}
+
+static Tree closeList(Tree last)
+{ Tree first;
+  if (last == NOTREE) return NOTREE;
+  first = SIBLING(last);
+  SIBLING(last) = NOTREE;
+  return first;
+}
+
+/* addDecl appends the top-level declaration t to
+ * the list ending at last, or hands it to the
+ * parser's declProc, leaving the list empty
+ */
+static Tree addDecl(Parser p, Tree last, Tree t)
+{ if (p->declProc == NULL) return appendList(last,t);
+  p->declProc(t);
+  return NOTREE;
+}
 
 %}
 
+%define api.pure full
+%define api.push-pull push
+%code requires { struct ParserRec; }
+%parse-param {struct ParserRec * p}
+
 %token IF ELSE WHILE RETURN INT VOID
 %token ID NUM 
 %token EQ NE LT LE GT GE
@@ -36,139 +94,92 @@ static int yylex(void); // added 11/2/11 to ensure no conflict with lex
 %% /* Grammar for TINY */
 
 program     : decl_list{
-                 savedTree = $1;
+                 p->savedTree = closeList($1);
               } 
             ;
-decl_list   : decl_list decl{
-                   YYSTYPE temp = $1;
-                   if (temp == NULL){
-                        $$ = $2; 
-                   }
-                   else{
-                        while (temp->sibling != NULL){
-                            temp = temp->sibling;
-                        }
-                        temp->sibling = $2;
-                        $$ = $1;
-                   }
-               }
-            | decl
+decl_list   : decl_list decl{ $$ = addDecl(p,$1,$2); }
+            | decl{ $$ = addDecl(p,NOTREE,$1); }
             ;
 decl        : var_decl
             | fun_decl
             ;
 saveName    : ID{
-                savedName = copyString(tokenString);
-                savedLineNo = lineno;
+                p->savedName = p->tok.name;
+                p->savedPos = p->tok.pos;
               }
             ;
 saveNumber  : NUM{
-                savedNumber = atoi(tokenString);
-                savedLineNo = lineno;
+                p->savedNumber = p->tok.val;
+                p->savedPos = p->tok.pos;
               }
             ;
 var_decl    : type_spec saveName SEMI{
                    $$ = newDeclNode(VarK);
-                   $$->child[0] = $1;
-                   $$->lineno = savedLineNo;
-                   $$->attr.name = savedName;
+                   SETCHILD($$,0,$1);
+                   POS($$) = p->savedPos;
+                   ATTR($$).name = p->savedName;
               }
             | type_spec saveName LBRACE saveNumber RBRACE SEMI{
                    $$ = newDeclNode(ArrVarK);
-                   $$->child[0] = $1;
-                   $$->lineno = savedLineNo;
-                   $$->attr.arr.name = savedName;
-                   $$->attr.arr.size = savedNumber;
+                   SETCHILD($$,0,$1);
+                   POS($$) = p->savedPos;
+                   ARRNAME($$) = p->savedName;
+                   SETARRSIZE($$,p->savedNumber);
               }
             ;            
 type_spec   : INT{
                 $$ = newTypeNode(TypeNameK);
-                $$->attr.type = INT;
+                ATTR($$).type = INT;
               }
             | VOID{
                 $$ = newTypeNode(TypeNameK);
-                $$->attr.type = VOID;
+                ATTR($$).type = VOID;
               }
             ;
 fun_decl    : type_spec saveName{ 
                    $$ = newDeclNode(FuncK);
-                   $$->lineno = savedLineNo;
-                   $$->attr.name = savedName;
+                   POS($$) = p->savedPos;
+                   ATTR($$).name = p->savedName;
               }
               LPAREN params RPAREN comp_stmt{
                    $$ = $3;
-                   $$->child[0] = $1;
-                   $$->child[1] = $5;
-                   $$->child[2] = $7;
+                   SETCHILD($$,0,$1);
+                   SETCHILD($$,1,$5);
+                   SETCHILD($$,2,$7);
               }
             ;
-params      : param_list
+params      : param_list{ $$ = closeList($1); }
             | type_spec{
                    $$ = newParamNode(NonArrParamK);
-                   $$->child[0] = $1;
-                   $$->attr.name = copyString("(null)");
+                   SETCHILD($$,0,$1);
+                   ATTR($$).name = p->nullName;
               }
             ;
-param_list  : param_list COMMA param{
-                   YYSTYPE temp = $1;
-                   if(temp == NULL){
-                       $$ = $3;
-                   }
-                   else{
-                       while (temp->sibling != NULL){
-                           temp = temp->sibling;
-                       }
-                       temp->sibling = $3;
-                       $$ = $1; 
-                   }
-              }
-            | param
+param_list  : param_list COMMA param{ $$ = appendList($1,$3); }
+            | param{ $$ = appendList(NOTREE,$1); }
             ;
 param       : type_spec saveName{
                    $$ = newParamNode(NonArrParamK);
-                   $$->child[0] = $1;
-                   $$->attr.name = savedName;
+                   SETCHILD($$,0,$1);
+                   ATTR($$).name = p->savedName;
               }
             | type_spec saveName LBRACE RBRACE{
                    $$ = newParamNode(ArrParamK);
-                   $$->child[0] = $1;
-                   $$->attr.name = savedName;
+                   SETCHILD($$,0,$1);
+                   ATTR($$).name = p->savedName;
               }
             ;
 comp_stmt   : LCURLY local_decls stmt_list RCURLY{
                    $$ = newStmtNode(CompK);
-                   $$->child[0] = $2;
-                   $$->child[1] = $3;
+                   SETCHILD($$,0,closeList($2));
+                   SETCHILD($$,1,closeList($3));
               }
             ;
-local_decls : local_decls var_decl{
-                   YYSTYPE temp = $1;
-                   if(temp == NULL){
-                        $$ = $2;
-                   }
-                   else{
-                        while (temp->sibling != NULL){
-                            temp = temp->sibling;
-                        }
-                        temp->sibling = $2;
-                        $$ = $1; 
-                   }
-              }
-            | { $$ = NULL; }
+local_decls : local_decls var_decl{ $$ = appendList($1,$2); }
+            | { $$ = NOTREE; }
             ;
-stmt_list   : stmt_list stmt{
-                   YYSTYPE temp = $1;
-                   if(temp == NULL){
-                        $$ = $2;
-                   }
-                   else{
-                        while (temp->sibling != NULL)
-                            temp = temp->sibling;
-                        temp->sibling = $2;
-                        $$ = $1; 
-                   }
-              }
-            | { $$ = NULL; }
+stmt_list   : stmt_list stmt{ $$ = appendList($1,$2); }
+            | { $$ = NOTREE; }
             ;
 stmt        : exp_stmt
             | comp_stmt
@@ -177,54 +188,50 @@ stmt        : exp_stmt
             | ret_stmt
             ;
 exp_stmt    : exp SEMI { $$= $1; }
-            | SEMI  { $$ = NULL; }
+            | SEMI  { $$ = NOTREE; }
             ;
 sel_stmt    : IF LPAREN exp RPAREN stmt %prec NO_ELSE{
                    $$ = newStmtNode(IfK);
-                   $$->child[0] = $3;
-                   $$->child[1] = $5;
-                   $$->child[2] = NULL;
+                   SETCHILD($$,0,$3);
+                   SETCHILD($$,1,$5);
               }
             | IF LPAREN exp RPAREN stmt ELSE stmt{
                    $$ = newStmtNode(IfEK);
-                   $$->child[0] = $3;
-                   $$->child[1] = $5;
-                   $$->child[2] = $7;
+                   SETCHILD($$,0,$3);
+                   SETCHILD($$,1,$5);
+                   SETCHILD($$,2,$7);
               }
             ;
 iter_stmt   : WHILE LPAREN exp RPAREN stmt{
                    $$ = newStmtNode(IterK);
-                   $$->child[0] = $3;
-                   $$->child[1] = $5;
+                   SETCHILD($$,0,$3);
+                   SETCHILD($$,1,$5);
               }
             ;
 ret_stmt    : RETURN SEMI{
                    $$ = newStmtNode(RetK);
-                   $$->child[0] = NULL;
+                   SETCHILD($$,0,NOTREE);
               }
             | RETURN exp SEMI{
                    $$ = newStmtNode(RetK);
-                   $$->child[0] = $2;
+                   SETCHILD($$,0,$2);
               }
             ;
 exp         : var ASSIGN exp{
                    $$ = newExpNode(AssignK);
-                   $$->child[0] = $1;
-                   $$->child[1] = $3;
+                   SETCHILD($$,0,$1);
+                   SETCHILD($$,1,$3);
               }
             | simple_exp
             ;
-var         : saveName{
-                   $$ = newExpNode(IdK);
-                   $$->attr.name = savedName;
-              }
+var         : saveName{ $$ = newIdLeaf(p->savedName); }
             | saveName{
                    $$ = newExpNode(ArrIdK);
-                   $$->attr.name = savedName;
+                   ATTR($$).name = p->savedName;
               }
               LBRACE exp RBRACE{
                    $$ = $2;
-                   $$->child[0] = $4;
+                   SETCHILD($$,0,$4);
               }
             ;
 /*relop -> LE | LT | GT | GE | EQ | NE
@@ -233,39 +240,39 @@ var         : saveName{
  */
 simple_exp  : add_exp LE add_exp{
                    $$ = newExpNode(OpK);
-                   $$->child[0] = $1;
-                   $$->child[1] = $3;
-                   $$->attr.op = LE;
+                   SETCHILD($$,0,$1);
+                   SETCHILD($$,1,$3);
+                   ATTR($$).op = LE;
               }
             | add_exp LT add_exp{
                    $$ = newExpNode(OpK);
-                   $$->child[0] = $1;
-                   $$->child[1] = $3;
-                   $$->attr.op = LT;
+                   SETCHILD($$,0,$1);
+                   SETCHILD($$,1,$3);
+                   ATTR($$).op = LT;
               }
             | add_exp GT add_exp{
                    $$ = newExpNode(OpK);
-                   $$->child[0] = $1;
-                   $$->child[1] = $3;
-                   $$->attr.op = GT;
+                   SETCHILD($$,0,$1);
+                   SETCHILD($$,1,$3);
+                   ATTR($$).op = GT;
               }
             | add_exp GE add_exp{
                    $$ = newExpNode(OpK);
-                   $$->child[0] = $1;
-                   $$->child[1] = $3;
-                   $$->attr.op = GE;
+                   SETCHILD($$,0,$1);
+                   SETCHILD($$,1,$3);
+                   ATTR($$).op = GE;
               }
             | add_exp EQ add_exp{
                    $$ = newExpNode(OpK);
-                   $$->child[0] = $1;
-                   $$->child[1] = $3;
-                   $$->attr.op = EQ;
+                   SETCHILD($$,0,$1);
+                   SETCHILD($$,1,$3);
+                   ATTR($$).op = EQ;
               }
             | add_exp NE add_exp{
                    $$ = newExpNode(OpK);
-                   $$->child[0] = $1;
-                   $$->child[1] = $3;
-                   $$->attr.op = NE;
+                   SETCHILD($$,0,$1);
+                   SETCHILD($$,1,$3);
+                   ATTR($$).op = NE;
               }
             | add_exp
             ;
@@ -275,15 +282,15 @@ simple_exp  : add_exp LE add_exp{
  */
 add_exp     : add_exp PLUS term{
                    $$ = newExpNode(OpK);
-                   $$->child[0] = $1;
-                   $$->child[1] = $3;
-                   $$->attr.op = PLUS;
+                   SETCHILD($$,0,$1);
+                   SETCHILD($$,1,$3);
+                   ATTR($$).op = PLUS;
               }
             | add_exp MINUS term{
                    $$ = newExpNode(OpK);
-                   $$->child[0] = $1;
-                   $$->child[1] = $3;
-                   $$->attr.op = MINUS;
+                   SETCHILD($$,0,$1);
+                   SETCHILD($$,1,$3);
+                   ATTR($$).op = MINUS;
               }
             | term
             ;
@@ -293,71 +300,128 @@ add_exp     : add_exp PLUS term{
  */
 term        : term TIMES factor{
                    $$ = newExpNode(OpK);
-                   $$->child[0] = $1;
-                   $$->child[1] = $3;
-                   $$->attr.op = TIMES;
+                   SETCHILD($$,0,$1);
+                   SETCHILD($$,1,$3);
+                   ATTR($$).op = TIMES;
               }
             | term OVER factor{
                    $$ = newExpNode(OpK);
-                   $$->child[0] = $1;
-                   $$->child[1] = $3;
-                   $$->attr.op = OVER;
+                   SETCHILD($$,0,$1);
+                   SETCHILD($$,1,$3);
+                   ATTR($$).op = OVER;
               }
             | factor
             ;
 factor      : LPAREN exp RPAREN { $$ = $2; }
             | var
             | call
-            | saveNumber{
-                   $$ = newExpNode(ConstK);
-                   $$->attr.val = savedNumber;
-              }
+            | saveNumber{ $$ = newConstLeaf(p->savedNumber); }
             ;
 call        : saveName{
                    $$ = newExpNode(CallK);
-                   $$->attr.name = savedName;
+                   ATTR($$).name = p->savedName;
               }
               LPAREN args RPAREN{
                    $$ = $2;
-                   $$->child[0] = $4;
+                   SETCHILD($$,0,$4);
               }
             ;
-args        : arg_list
-            | { $$ = NULL; }
+args        : arg_list{ $$ = closeList($1); }
+            | { $$ = NOTREE; }
             ;
-arg_list    : arg_list COMMA exp{
-                   YYSTYPE temp = $1;
-                   if(temp == NULL){
-                        $$ = $3;
-                   }
-                   else{
-                        while (temp->sibling != NULL)
-                            temp = temp->sibling;
-                        temp->sibling = $3;
-                        $$ = $1; 
-                   }
-              }
-            | exp
+arg_list    : arg_list COMMA exp{ $$ = appendList($1,$3); }
+            | exp{ $$ = appendList(NOTREE,$1); }
             ;
 
 %%
 
-int yyerror(char * message)
-{ fprintf(listing,"Syntax error at line %d: %s\n",lineno,message);
+static int yyerror(Parser p, char * message)
+{ if (p->muted) return 0;
+  fprintf(listing,"Syntax error at line %d, column %d: %s\n",
+          lineOf(p->tok.pos),columnOf(p->tok.pos),message);
   fprintf(listing,"Current token: ");
-  printToken(yychar,tokenString);
+  { char * lexeme = copySpan(p->tok.span);
+    printToken(p->tok.kind,lexeme);
+    free(lexeme);
+  }
   Error = TRUE;
   return 0;
 }
 
-/* yylex calls getToken to make Yacc/Bison output
- * compatible with ealier versions of the TINY scanner
- */
-static int yylex(void)
-{ return getToken(); }
+Parser newParser(void)
+{ Parser p = calloc(1,sizeof(struct ParserRec));
+  if (p == NULL || (p->ps = yypstate_new()) == NULL)
+  { fprintf(listing,"Out of memory error creating a parser\n");
+    exit(1);
+  }
+  p->nullName = intern("(null)",6);
+  p->savedTree = NOTREE;
+  p->status = YYPUSH_MORE;
+  return p;
+}
+
+int pushToken(Parser p, Token * tok)
+{ YYSTYPE none = NOTREE;
+  if (p->status != YYPUSH_MORE) return FALSE;
+  p->tok = *tok;
+  srcpos = tok->pos; /* for the nodes made now */
+  p->status = yypush_parse(p->ps,tok->kind,&none,p);
+  return p->status == YYPUSH_MORE;
+}
+
+void streamDecls(Parser p, DeclProc proc)
+{ p->declProc = proc; }
 
-TreeNode * parse(void)
-{ yyparse();
-  return savedTree;
+void muteParser(Parser p)
+{ p->muted = TRUE; }
+
+Tree parserTree(Parser p)
+{ return p->status == 0 ? p->savedTree : NOTREE; }
+
+void freeParser(Parser p)
+{ yypstate_delete(p->ps);
+  free(p);
+}
+
+/* pullParse pulls the tokens from getToken and
+ * pushes them into a parser of its own, which hands
+ * the declarations to proc unless it is NULL
+ */
+static Tree pullParse(DeclProc proc)
+{ Parser p;
+  Token tok;
+  Tree t;
+  if (ParallelParse && proc == NULL &&
+      (ScanMode == BatchScan || ScanMode == ParallelScan))
+  { t = parseParallel();
+    /* otherwise parsed again serially, which
+       reports any syntax error */
+    if (t != NOTREE) return t;
+  }
+  if (DescentParse)
+  { t = descentParse(proc);
+    endTokens();
+    return t;
+  }
+  /* made before a scanner thread may start, as
+     it interns a name */
+  p = newParser();
+  streamDecls(p,proc);
+  do
+  { tok.kind = getToken();
+    tok.span = tokenSpan;
+    tok.pos = srcpos;
+    tok.val = tokenValue;
+    tok.name = tokenName;
+  } while (pushToken(p,&tok));
+  endTokens();
+  t = parserTree(p);
+  freeParser(p);
+  return t;
 }
 
+Tree parse(void)
+{ return pullParse(NULL); }
+
+void streamParse(DeclProc proc)
+{ pullParse(proc); }
@@ -53,11 +53,25 @@
  */
 typedef int TokenType;
 
+/* TokenSpan locates a lexeme in the source buffer,
+ * which stays in memory for the whole compilation;
+ * the lexeme is not NUL terminated
+ */
+typedef struct
+   { const char * str;
+     int len;
+   } TokenSpan;
+
 extern FILE* source; /* source code text file */
 extern FILE* listing; /* listing output text file */
 extern FILE* code; /* code text file for TM simulator */
 
-extern int lineno; /* source line number for listing */
+/* srcpos = byte offset in the source of the current
+ * token; see lines.h for its line and column. Each
+ * thread has its own, as parsers may run on several
+ * (see pparse.h)
+ */
+extern __thread unsigned int srcpos;
 
 /**************************************************/
 /***********   Syntax tree for parsing ************/
@@ -85,7 +99,7 @@ typedef enum {Void,Integer, IntegerArray} ExpType;
 typedef struct treeNode
    { struct treeNode * child[MAXCHILDREN];
      struct treeNode * sibling;
-     int lineno;
+     unsigned int pos; /* source offset, see lines.h */
      NodeKind nodekind;
      union { StmtKind stmt; 
              ExpKind exp; 
@@ -96,10 +110,106 @@ typedef struct treeNode
              TokenType type;
              int val;
              char * name;
-             ArrayAttr arr; } attr;
+             ArrayAttr arr;
+             struct ScopeListRec * scope; /* of a CompK */ } attr;
      ExpType type; /* for type checking of exps */
    } TreeNode;
 
+/* COMPACT_AST = TRUE keeps the syntax tree in the
+ * compact layout below instead of TreeNodes; the
+ * parser, the analyzer and printTree reach nodes
+ * only through a Tree and the accessors, so they
+ * work with either layout
+ */
+#ifndef COMPACT_AST
+#define COMPACT_AST FALSE
+#endif
+
+/* HASH_CONS = TRUE shares the ConstK and IdK leaves
+ * of the syntax tree that are alike (see
+ * newConstLeaf in util.h): a leaf may then have
+ * several parents, and never has a sibling
+ */
+#ifndef HASH_CONS
+#define HASH_CONS FALSE
+#endif
+
+#if COMPACT_AST
+
+/* (the accessors may evaluate their arguments more
+ * than once, and a child given to SETCHILD must not
+ * be made in the same expression, as making nodes
+ * may move astKids)
+ *
+ * a Tree is the index of its node in astNode, and
+ * NOTREE (0) is no node; each node has as many
+ * child slots as its kind needs (see ast.c), kept
+ * together in astKids from index kids on; an
+ * ArrVarK keeps its size in the slot after its
+ * child
+ */
+typedef unsigned int Tree;
+#define NOTREE 0
+
+typedef struct
+   { unsigned char nodekind;
+     unsigned char kind;
+     unsigned char type; /* ExpType */
+     unsigned char nkids;
+     unsigned int pos;
+     Tree sibling;
+     unsigned int kids;
+     union { TokenType op;
+             TokenType type;
+             int val;
+             char * name;
+             struct ScopeListRec * scope; } attr;
+   } AstNode;
+
+/* each thread builds in arrays of its own */
+extern __thread AstNode * astNode;
+extern __thread Tree * astKids;
+
+#define NODEKIND(t) ((NodeKind) astNode[t].nodekind)
+#define STMTKIND(t) ((StmtKind) astNode[t].kind)
+#define EXPKIND(t) ((ExpKind) astNode[t].kind)
+#define DECLKIND(t) ((DeclKind) astNode[t].kind)
+#define PARAMKIND(t) ((ParamKind) astNode[t].kind)
+#define TYPEKIND(t) ((TypeKind) astNode[t].kind)
+#define CHILD(t,i) \
+  ((i) < astNode[t].nkids ? astKids[astNode[t].kids+(i)] : NOTREE)
+#define SETCHILD(t,i,c) (astKids[astNode[t].kids+(i)] = (c))
+#define SIBLING(t) (astNode[t].sibling)
+#define POS(t) (astNode[t].pos)
+#define EXPTYPE(t) (astNode[t].type)
+#define ATTR(t) (astNode[t].attr)
+#define ARRNAME(t) (astNode[t].attr.name)
+#define ARRSIZE(t) ((int) astKids[astNode[t].kids+1])
+#define SETARRSIZE(t,n) (astKids[astNode[t].kids+1] = (Tree) (n))
+
+#else
+
+typedef TreeNode * Tree;
+#define NOTREE NULL
+
+#define NODEKIND(t) ((t)->nodekind)
+#define STMTKIND(t) ((t)->kind.stmt)
+#define EXPKIND(t) ((t)->kind.exp)
+#define DECLKIND(t) ((t)->kind.decl)
+#define PARAMKIND(t) ((t)->kind.param)
+#define TYPEKIND(t) ((t)->kind.type)
+#define CHILD(t,i) ((t)->child[i])
+#define SETCHILD(t,i,c) ((t)->child[i] = (c))
+#define SIBLING(t) ((t)->sibling)
+#define POS(t) ((t)->pos)
+#define EXPTYPE(t) ((t)->type)
+#define ATTR(t) ((t)->attr)
+#define ARRNAME(t) ((t)->attr.arr.name)
+#define ARRSIZE(t) ((t)->attr.arr.size)
+#define SETARRSIZE(t,n) ((t)->attr.arr.size = (n))
+
+#endif
+
 /**************************************************/
 /***********   Flags for tracing       ************/
 /**************************************************/
@@ -110,6 +220,34 @@ typedef struct treeNode
  */
 extern int EchoSource;
 
+/* ScanMode selects how the parser gets its tokens:
+ * StreamScan calls the scanner for each token,
+ * BatchScan scans the whole source into a token
+ * array first, ThreadScan runs the scanner on
+ * its own thread, overlapping it with parsing, and
+ * ParallelScan splits the source among several
+ * scanner threads (see pscan.h). With TraceScan
+ * on, StreamScan is always used, so that the
+ * trace of each token comes as it is parsed and
+ * stops at a syntax error; a streamed compilation
+ * (see main.c) uses it instead of BatchScan and
+ * ThreadScan
+ */
+typedef enum {StreamScan,BatchScan,ThreadScan,ParallelScan} ScanModeKind;
+extern ScanModeKind ScanMode;
+
+/* DescentParse = TRUE parses with the recursive-
+ * descent parser (see parse.h) instead of the
+ * Yacc/Bison one
+ */
+extern int DescentParse;
+
+/* ParallelParse = TRUE parses the top-level
+ * declarations on several threads (see pparse.h)
+ * when the whole source is scanned first
+ */
+extern int ParallelParse;
+
 /* TraceScan = TRUE causes token information to be
  * printed to the listing file as each token is
  * recognized by the scanner
@@ -0,0 +1,96 @@
+/****************************************************/
+/* File: intern.c                                   */
+/* Identifier interning for the C-minus compiler    */
+/* The table is a chained hash table that doubles   */
+/* when it gets full; each record keeps the hash    */
+/* of its name, and the name itself is stored at    */
+/* the end of the record; the records are taken    */
+/* from an arena (see arena.h)                      */
+/****************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include "intern.h"
+#include "arena.h"
+
+/* initial number of buckets (a power of two) */
+#define INITSIZE 256
+
+typedef struct InternRec
+   { struct InternRec * next;
+     unsigned int hash;
+     int len;
+     char name[1]; /* len+1 characters */
+   } * InternList;
+
+static InternList * table = NULL;
+static int tableSize = 0;
+static int count = 0;
+static Arena nameArena;
+
+/* FNV-1a hash of the len characters at s */
+static unsigned int hash(const char * s, int len)
+{ unsigned int h = 2166136261u;
+  int i;
+  for (i=0;i<len;i++)
+  { h ^= (unsigned char) s[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+/* grow doubles the table, reusing the stored hashes */
+static void grow(void)
+{ int newSize = tableSize ? tableSize*2 : INITSIZE;
+  InternList * newTable = calloc(newSize,sizeof(InternList));
+  int i;
+  if (newTable == NULL) return; /* keep the longer chains */
+  for (i=0;i<tableSize;i++)
+  { InternList l = table[i];
+    while (l != NULL)
+    { InternList next = l->next;
+      int h = l->hash & (newSize-1);
+      l->next = newTable[h];
+      newTable[h] = l;
+      l = next;
+    }
+  }
+  free(table);
+  table = newTable;
+  tableSize = newSize;
+}
+
+char * intern( const char * s, int len )
+{ unsigned int h = hash(s,len);
+  InternList l;
+  if (count >= tableSize) grow();
+  if (table == NULL) return NULL;
+  l = table[h & (tableSize-1)];
+  while ((l != NULL) &&
+         (l->hash != h || l->len != len || memcmp(l->name,s,len) != 0))
+    l = l->next;
+  if (l == NULL) /* first occurrence of the name */
+  { l = arenaAlloc(&nameArena,offsetof(struct InternRec,name) + len + 1);
+    if (l == NULL) return NULL;
+    l->hash = h;
+    l->len = len;
+    memcpy(l->name,s,len);
+    l->name[len] = '\0';
+    l->next = table[h & (tableSize-1)];
+    table[h & (tableSize-1)] = l;
+    count++;
+  }
+  return l->name;
+}
+
+unsigned int internHash( const char * name )
+{ return ((InternList)(name - offsetof(struct InternRec,name)))->hash;
+}
+
+void releaseNames( void )
+{ free(table);
+  table = NULL;
+  tableSize = count = 0;
+  arenaRelease(&nameArena);
+}
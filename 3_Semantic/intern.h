@@ -0,0 +1,28 @@
+/****************************************************/
+/* File: intern.h                                   */
+/* Identifier interning for the C-minus compiler    */
+/****************************************************/
+
+#ifndef _INTERN_H_
+#define _INTERN_H_
+
+/* Function intern returns the unique copy of the
+ * identifier s of length len (s need not be NUL
+ * terminated). Equal identifiers always get the
+ * same pointer, so interned names can be compared
+ * with == instead of strcmp
+ */
+char * intern( const char * s, int len );
+
+/* Function internHash returns the hash computed
+ * once when name was interned
+ */
+unsigned int internHash( const char * name );
+
+/* Procedure releaseNames frees all the interned
+ * names at once, at the end of a compilation;
+ * names interned earlier must not be used again
+ */
+void releaseNames( void );
+
+#endif
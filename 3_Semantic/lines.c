@@ -0,0 +1,98 @@
+/****************************************************/
+/* File: lines.c                                    */
+/* Source positions for the C-minus compiler        */
+/* The newline index is built in one pass over the  */
+/* source (16 bytes at a time with SSE2); a         */
+/* position is turned into a line by binary search  */
+/****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lines.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* lineStart[i] is the offset at which line i+1 starts */
+static unsigned int * lineStart = NULL;
+static int lineCount = 0;
+static int lineCap = 0;
+
+/* growLines makes room for n lines */
+static void growLines(int n)
+{ if (n <= lineCap) return;
+  while (lineCap < n) lineCap = lineCap ? lineCap*2 : 1024;
+  lineStart = realloc(lineStart,lineCap*sizeof(unsigned int));
+  if (lineStart == NULL)
+  { fprintf(stderr,"Out of memory error indexing lines\n");
+    exit(1);
+  }
+}
+
+static void addLine(unsigned int pos)
+{ growLines(lineCount+1);
+  lineStart[lineCount++] = pos;
+}
+
+void indexLines( const char * buf, unsigned int len )
+{ unsigned int i = 0;
+  lineCount = 0;
+  addLine(0);
+#if defined(__SSE2__)
+  { __m128i nl = _mm_set1_epi8('\n');
+    for (; len - i >= 16; i += 16)
+    { unsigned int m = _mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(buf+i)),nl));
+      while (m != 0)
+      { addLine(i + __builtin_ctz(m) + 1);
+        m &= m - 1;
+      }
+    }
+  }
+#endif
+  for (; i < len; i++)
+    if (buf[i] == '\n') addLine(i+1);
+}
+
+/* findLine returns the index in lineStart of
+ * the line holding pos
+ */
+static int findLine(unsigned int pos)
+{ int lo = 0, hi = lineCount - 1;
+  while (lo < hi)
+  { int mid = (lo + hi + 1) / 2;
+    if (lineStart[mid] <= pos) lo = mid;
+    else hi = mid - 1;
+  }
+  return lo;
+}
+
+void editLines( unsigned int pos, int deleted,
+                const char * ins, int inserted )
+{ int first = findLine(pos) + 1; /* first line starting after pos */
+  int last = first; /* first line starting after the deleted text */
+  int added = 0, i, j;
+  for (i=0;i<inserted;i++)
+    if (ins[i] == '\n') added++;
+  while (last < lineCount && lineStart[last] <= pos + deleted) last++;
+  growLines(lineCount - (last - first) + added);
+  memmove(lineStart + first + added,lineStart + last,
+          (lineCount - last) * sizeof(unsigned int));
+  lineCount += added - (last - first);
+  for (i=first+added;i<lineCount;i++)
+    lineStart[i] += inserted - deleted;
+  for (i=0,j=first;i<inserted;i++)
+    if (ins[i] == '\n') lineStart[j++] = pos + i + 1;
+}
+
+int lineOf( unsigned int pos )
+{ if (lineCount == 0) return 0; /* no source read yet */
+  return findLine(pos) + 1;
+}
+
+int columnOf( unsigned int pos )
+{ if (lineCount == 0) return 0;
+  return pos - lineStart[findLine(pos)] + 1;
+}
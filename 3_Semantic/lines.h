@@ -0,0 +1,36 @@
+/****************************************************/
+/* File: lines.h                                    */
+/* Source positions for the C-minus compiler:       */
+/* tokens and tree nodes carry the byte offset of   */
+/* their text in the source; lines and columns are  */
+/* worked out from it only when they are printed    */
+/****************************************************/
+
+#ifndef _LINES_H_
+#define _LINES_H_
+
+/* Procedure indexLines records where each line of
+ * the len characters of source at buf starts;
+ * it is called once, when the source is read
+ */
+void indexLines( const char * buf, unsigned int len );
+
+/* Procedure editLines updates the index after
+ * the deleted characters at pos of the source
+ * have been replaced with the inserted characters
+ * at ins
+ */
+void editLines( unsigned int pos, int deleted,
+                const char * ins, int inserted );
+
+/* Function lineOf returns the line (from 1) of
+ * the byte offset pos in the source
+ */
+int lineOf( unsigned int pos );
+
+/* Function columnOf returns the column (from 1)
+ * of the byte offset pos in the source
+ */
+int columnOf( unsigned int pos );
+
+#endif
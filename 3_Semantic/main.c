@@ -9,19 +9,55 @@
 
 /* set NO_PARSE to TRUE to get a scanner-only compiler */
 #define NO_PARSE FALSE
-/* set NO_ANALYZE to TRUE to get a parser-only compiler */
+/* set NO_ANALYZE to TRUE (e.g. with -DNO_ANALYZE=TRUE)
+ * to get a parser-only compiler
+ */
+#ifndef NO_ANALYZE
 #define NO_ANALYZE FALSE
+#endif
 
 /* set NO_CODE to TRUE to get a compiler that does not
  * generate code
  */
 #define NO_CODE TRUE
 
+/* CACHEVAR names the environment variable that
+ * holds the directory of the syntax tree cache
+ * (see treecache.h); without it nothing is cached
+ */
+#define CACHEVAR "CMINUS_CACHE"
+
+/* STREAMVAR names the environment variable that,
+ * when set, makes the compiler analyze each
+ * top-level declaration as soon as it is parsed
+ * and then free its syntax tree, so that memory
+ * does not grow with the program; the listing is
+ * that of a whole-program compilation, except
+ * that messages come declaration by declaration
+ */
+#define STREAMVAR "CMINUS_STREAM"
+
+/* set DESCENT_PARSE to TRUE (e.g. with
+ * -DDESCENT_PARSE=TRUE) to parse by recursive
+ * descent, or PARALLEL_PARSE to TRUE to parse on
+ * several threads, unless PARSERVAR says otherwise;
+ * the environment variable PARSERVAR may be
+ * "descent", "parallel" or "yacc"
+ */
+#ifndef DESCENT_PARSE
+#define DESCENT_PARSE FALSE
+#endif
+#ifndef PARALLEL_PARSE
+#define PARALLEL_PARSE FALSE
+#endif
+#define PARSERVAR "CMINUS_PARSER"
+
 #include "util.h"
-#if NO_PARSE
+#include "intern.h"
 #include "scan.h"
-#else
+#if !NO_PARSE
 #include "parse.h"
+#include "treecache.h"
 #if !NO_ANALYZE
 #include "analyze.h"
 #if !NO_CODE
@@ -31,13 +67,16 @@
 #endif
 
 /* allocate global variables */
-int lineno = 0;
+__thread unsigned int srcpos = 0;
 FILE * source;
 FILE * listing;
 FILE * code;
 
 /* allocate and set tracing flags */
 int EchoSource = FALSE;
+ScanModeKind ScanMode = BatchScan;
+int DescentParse = DESCENT_PARSE;
+int ParallelParse = PARALLEL_PARSE;
 int TraceScan = FALSE;
 int TraceParse = FALSE;
 int TraceAnalyze = FALSE;
@@ -45,8 +84,19 @@ int TraceCode = FALSE;
 
 int Error = FALSE;
 
+#if !NO_PARSE && !NO_ANALYZE
+/* compileDecl takes each declaration of a
+ * streamed compilation
+ */
+static void compileDecl(Tree decl)
+{ if (TraceParse) printTree(decl);
+  if (! Error) analyzeDecl(decl);
+  releaseTree();
+}
+#endif
+
 main( int argc, char * argv[] )
-{ TreeNode * syntaxTree;
+{ Tree syntaxTree;
   char pgm[120]; /* source code file name */
   if (argc != 2)
     { fprintf(stderr,"usage: %s <filename>\n",argv[0]);
@@ -65,10 +115,39 @@ main( int argc, char * argv[] )
 #if NO_PARSE
   while (getToken()!=ENDFILE);
 #else
-  syntaxTree = parse();
-  if (TraceParse) {
-    fprintf(listing,"\nSyntax tree:\n");
-    printTree(syntaxTree);
+  { char * parser = getenv(PARSERVAR);
+    if (parser != NULL)
+    { DescentParse = strcmp(parser,"descent") == 0;
+      ParallelParse = strcmp(parser,"parallel") == 0;
+    }
+  }
+  /* the scanner's trace is kept in step with parsing */
+  if (TraceScan) ScanMode = StreamScan;
+#if !NO_ANALYZE
+  if (getenv(STREAMVAR) != NULL)
+  { /* the tokens are not all kept either; nor may
+       a scanner thread run, as each declaration is
+       analyzed, interning names, while the scanner
+       interns those of the tokens after it (the
+       threads of ParallelScan are done by then) */
+    if (ScanMode != ParallelScan) ScanMode = StreamScan;
+    if (TraceParse) fprintf(listing,"\nSyntax tree:\n");
+    streamParse(compileDecl);
+    syntaxTree = NOTREE;
+  }
+  else
+#endif
+  { char * cacheDir = getenv(CACHEVAR);
+    /* a cached tree cannot trace the scanner */
+    syntaxTree = cacheDir != NULL && !TraceScan ? loadTree(cacheDir) : NOTREE;
+    if (syntaxTree == NOTREE)
+    { syntaxTree = parse();
+      if (cacheDir != NULL && !Error) saveTree(cacheDir,syntaxTree);
+    }
+    if (TraceParse) {
+      fprintf(listing,"\nSyntax tree:\n");
+      printTree(syntaxTree);
+    }
   }
 #if !NO_ANALYZE
   if (! Error)
@@ -100,6 +179,9 @@ main( int argc, char * argv[] )
 #endif
 #endif
 #endif
+  /* the tree and the names go in one release each */
+  releaseTree();
+  releaseNames();
   fclose(source);
   return 0;
 }
@@ -8,9 +8,71 @@
 #ifndef _PARSE_H_
 #define _PARSE_H_
 
+/* a Parser holds one parse in progress, into which
+ * the caller pushes the tokens (see scan.h) as they
+ * become available; several may be in progress at
+ * once, and each builds its own syntax tree
+ */
+typedef struct ParserRec * Parser;
+
+/* a DeclProc takes each top-level declaration of
+ * a program as soon as it has been parsed
+ */
+typedef void (* DeclProc)(Tree);
+
+/* Function newParser returns a parser waiting for
+ * the first token of a program
+ */
+Parser newParser(void);
+
+/* Function pushToken feeds the next token to p,
+ * ENDFILE last; it returns TRUE while p needs more
+ * tokens, and FALSE once the program is complete
+ * or a syntax error has been reported
+ */
+int pushToken(Parser p, Token * tok);
+
+/* Procedure streamDecls makes p hand each
+ * top-level declaration to proc instead of keeping
+ * it in the syntax tree, which is then NOTREE
+ */
+void streamDecls(Parser p, DeclProc proc);
+
+/* Procedure muteParser keeps p from reporting a
+ * syntax error; it still stops at the first, and
+ * parserTree then returns NOTREE
+ */
+void muteParser(Parser p);
+
+/* Function parserTree returns the syntax tree
+ * built by p, or NOTREE unless the whole program
+ * was parsed without error
+ */
+Tree parserTree(Parser p);
+
+/* Procedure freeParser frees p but not its tree */
+void freeParser(Parser p);
+
+/* Function descentParse returns the syntax tree
+ * of the tokens of getToken, built by recursive
+ * descent; the tree, positions included, is the
+ * one the Yacc/Bison parser builds. Unless proc is
+ * NULL, the declarations go to proc as they are
+ * parsed, as with streamDecls
+ */
+Tree descentParse(DeclProc proc);
+
 /* Function parse returns the newly 
- * constructed syntax tree
+ * constructed syntax tree, parsing the
+ * tokens of getToken with the parser that
+ * DescentParse selects
+ */
+Tree parse(void);
+
+/* Procedure streamParse parses as parse does, but
+ * hands each top-level declaration to proc as soon
+ * as it has been parsed
  */
-TreeNode * parse(void);
+void streamParse(DeclProc proc);
 
 #endif
@@ -0,0 +1,212 @@
+/****************************************************/
+/* File: parsebench.c                               */
+/* Scaling benchmark for the C-minus parser:        */
+/* generates programs with ever longer declaration, */
+/* statement, parameter and argument lists, and     */
+/* reports the parse time per list element, which   */
+/* stays flat when lists are built in linear time;  */
+/* the funcs programs, of functions with loops,     */
+/* conditions and arithmetic, compare parsers on    */
+/* realistic code                                   */
+/*                                                  */
+/* usage: parsebench <maxcount> <compiler>...       */
+/*   maxcount: longest list, e.g. 64K or 1M         */
+/*   compiler: built with -DNO_ANALYZE=TRUE         */
+/*                                                  */
+/* runs are timed and checked as in scanbench.c of  */
+/* the scanner, which should be kept in step        */
+/****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+/* list lengths are grown by this factor from 1K */
+#define COUNTSTEP 4
+
+/* runs per measurement; the fastest is reported */
+#define RUNS 3
+
+typedef enum {GlobalList,StmtList,LocalList,ParamList,ArgList,FuncList} ListKind;
+
+static char * kindName[] = {"globals","stmts","locals","params","args","funcs"};
+
+/* putName writes a distinct identifier for i
+ * (C-minus identifiers are letters only); no
+ * reserved word starts with x
+ */
+static void putName(FILE * f, long i)
+{ putc('x',f);
+  do
+  { putc('a' + i % 26,f);
+    i /= 26;
+  } while (i > 0);
+}
+
+/* makeProgram writes a program with a list of
+ * count elements of the given kind into path
+ */
+static int makeProgram(char * path, ListKind kind, long count)
+{ FILE * f = fopen(path,"w");
+  long i;
+  if (f == NULL) return -1;
+  switch (kind)
+  { case GlobalList:
+      for (i=0;i<count;i++)
+      { fputs("int ",f); putName(f,i); fputs(";\n",f); }
+      fputs("void main(void) { }\n",f);
+      break;
+    case StmtList:
+      fputs("void main(void)\n{ int x;\n",f);
+      for (i=0;i<count;i++)
+        fputs("  x = x + 1;\n",f);
+      fputs("}\n",f);
+      break;
+    case LocalList:
+      fputs("void main(void)\n{\n",f);
+      for (i=0;i<count;i++)
+      { fputs("  int ",f); putName(f,i); fputs(";\n",f); }
+      fputs("}\n",f);
+      break;
+    case ParamList:
+      fputs("void f(int ",f); putName(f,0);
+      for (i=1;i<count;i++)
+      { fputs(i % 16 ? ", int " : ",\n       int ",f); putName(f,i); }
+      fputs(")\n{ }\n",f);
+      fputs("void main(void) { }\n",f);
+      break;
+    case ArgList:
+      fputs("void f(int a)\n{ }\n",f);
+      fputs("void main(void)\n{ int x;\n  f(x",f);
+      for (i=1;i<count;i++)
+        fputs(i % 16 ? ", x" : ",\n    x",f);
+      fputs(");\n}\n",f);
+      break;
+    case FuncList:
+      for (i=0;i<count;i++)
+      { fputs("int ",f); putName(f,i);
+        fputs("(int a[], int n)\n"
+              "{ int i; int s;\n"
+              "  i = 0; s = 0;\n"
+              "  while (i < n)\n"
+              "  { if (a[i] * 2 >= (s - 1) / 3) s = s + a[i] * i;\n"
+              "    else { s = s - (i + 1); a[i] = s; }\n"
+              "    i = i + 1;\n"
+              "  }\n",f);
+        if (i > 0)
+        { fputs("  return ",f); putName(f,i-1); fputs("(a, s);\n}\n",f); }
+        else fputs("  return s;\n}\n",f);
+      }
+      fputs("void main(void) { }\n",f);
+      break;
+  }
+  return fclose(f);
+}
+
+/* SYNTAXERROR starts the message of a parser that
+ * rejects the program; the compilers exit with 0
+ * all the same
+ */
+#define SYNTAXERROR "Syntax error"
+
+/* runCompiler runs compiler on path, returning the
+ * elapsed seconds, or -1 on failure, including a
+ * syntax error in its listing
+ */
+static double runCompiler(char * compiler, char * path)
+{ int fd[2];
+  pid_t pid;
+  int status;
+  int rejected = 0;
+  struct timespec t0, t1;
+  char out[4096];
+  size_t n = 0;
+  ssize_t r;
+  if (pipe(fd) != 0) return -1;
+  clock_gettime(CLOCK_MONOTONIC,&t0);
+  pid = fork();
+  if (pid < 0) return -1;
+  if (pid == 0)
+  { dup2(fd[1],1);
+    close(fd[0]);
+    close(fd[1]);
+    execl(compiler,compiler,path,(char *)NULL);
+    _exit(127);
+  }
+  close(fd[1]);
+  while ((r = read(fd[0],out+n,sizeof(out)-1-n)) > 0)
+  { n += r;
+    out[n] = '\0';
+    if (strstr(out,SYNTAXERROR) != NULL) rejected = 1;
+    if (n == sizeof(out)-1)
+    { /* keep only a tail that may start the message */
+      size_t keep = sizeof(SYNTAXERROR) - 2;
+      memmove(out,out+n-keep,keep);
+      n = keep;
+    }
+  }
+  close(fd[0]);
+  if (waitpid(pid,&status,0) < 0) return -1;
+  clock_gettime(CLOCK_MONOTONIC,&t1);
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || rejected) return -1;
+  return (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9;
+}
+
+/* parseCount reads counts such as 4096, 64K or 1M */
+static long parseCount(char * s)
+{ char * end;
+  long n = strtol(s,&end,10);
+  switch (*end)
+  { case 'k': case 'K': return n << 10;
+    case 'm': case 'M': return n << 20;
+    default: return n;
+  }
+}
+
+int main(int argc, char * argv[])
+{ char dir[] = "/tmp/parsebenchXXXXXX";
+  char path[64];
+  long maxCount, count;
+  int kind, c, run;
+  if (argc < 3)
+  { fprintf(stderr,"usage: %s <maxcount> <compiler>...\n",argv[0]);
+    exit(1);
+  }
+  maxCount = parseCount(argv[1]);
+  if (mkdtemp(dir) == NULL)
+  { fprintf(stderr,"cannot create a directory for the programs\n");
+    exit(1);
+  }
+  sprintf(path,"%s/list.cm",dir);
+  printf("%-8s %10s  %-16s %10s %12s\n",
+         "list","elements","compiler","seconds","ns/element");
+  fflush(stdout); /* not to be copied into the children */
+  for (kind=GlobalList;kind<=FuncList;kind++)
+    for (count=1024;count<=maxCount;count*=COUNTSTEP)
+    { if (makeProgram(path,kind,count) != 0)
+      { fprintf(stderr,"cannot write %s\n",path);
+        exit(1);
+      }
+      for (c=2;c<argc;c++)
+      { double best = -1;
+        for (run=0;run<RUNS;run++)
+        { double t = runCompiler(argv[c],path);
+          if (t < 0) break;
+          if (best < 0 || t < best) best = t;
+        }
+        if (best < 0)
+          printf("%-8s %10ld  %-16s %10s\n",kindName[kind],count,argv[c],"failed");
+        else
+          printf("%-8s %10ld  %-16s %10.4f %12.1f\n",
+                 kindName[kind],count,argv[c],best,best/count*1e9);
+        fflush(stdout);
+      }
+      remove(path);
+    }
+  rmdir(dir);
+  return 0;
+}
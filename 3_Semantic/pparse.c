@@ -0,0 +1,103 @@
+/****************************************************/
+/* File: pparse.c                                   */
+/* Parallel parser for the C-minus compiler         */
+/* Pieces of the token array, each made of whole    */
+/* top-level declarations, are pushed into parsers  */
+/* (see parse.h) on several threads at once, each   */
+/* building its nodes apart (see takeTree in        */
+/* util.h)                                          */
+/****************************************************/
+
+#include "globals.h"
+#include "util.h"
+#include "scan.h"
+#include "tokens.h"
+#include "parse.h"
+#include "pscan.h"
+#include "pparse.h"
+#include <pthread.h>
+#include <unistd.h>
+
+/* Piece is the tokens [first,last) of tokenArray,
+ * with the parser for them and what it built
+ */
+typedef struct
+   { int first;
+     int last;
+     Parser parser;
+     Tree tree; /* the list of declarations */
+     TreePart part; /* the nodes, for joinTree */
+   } Piece;
+
+/* parseWorker parses one piece, followed by the
+ * ENDFILE of the source
+ */
+static void * parseWorker(void * arg)
+{ Piece * piece = arg;
+  int i = piece->first;
+  while (i < piece->last && pushToken(piece->parser,&tokenArray[i])) i++;
+  if (i == piece->last) pushToken(piece->parser,&tokenArray[tokenCount-1]);
+  piece->tree = parserTree(piece->parser);
+  piece->part = takeTree();
+  return NULL;
+}
+
+Tree parseParallel(void)
+{ Piece piece[MAXPARSETHREADS];
+  pthread_t thread[MAXPARSETHREADS];
+  int started[MAXPARSETHREADS];
+  int n, i, k, depth, end;
+  Tree first = NOTREE, last = NOTREE;
+  int ok = TRUE;
+  if (tokenArray == NULL)
+  { if (ScanMode == ParallelScan) scanParallel();
+    else scanAll();
+  }
+  end = tokenCount - 1; /* the ENDFILE */
+  n = sysconf(_SC_NPROCESSORS_ONLN);
+  if (n > end / MINPIECE) n = end / MINPIECE;
+  if (n > MAXPARSETHREADS) n = MAXPARSETHREADS;
+  if (n < 2) return NOTREE;
+  /* end each piece at the first declaration end
+   * after each nth part of the tokens
+   */
+  depth = 0;
+  k = 0;
+  piece[0].first = 0;
+  for (i=0;i<end && k<n-1;i++)
+  { TokenType kind = tokenArray[i].kind;
+    if (kind == LCURLY) depth++;
+    else if (kind == RCURLY) depth--;
+    if (depth == 0 && (kind == SEMI || kind == RCURLY) &&
+        i+1 >= (long) end * (k+1) / n && i+1 < end)
+    { piece[k].last = i+1;
+      piece[++k].first = i+1;
+    }
+  }
+  piece[k].last = end;
+  n = k+1;
+  /* made here, as a parser interns a name */
+  for (i=0;i<n;i++)
+  { piece[i].parser = newParser();
+    muteParser(piece[i].parser);
+  }
+  for (i=1;i<n;i++)
+    started[i] = pthread_create(&thread[i],NULL,parseWorker,&piece[i]) == 0;
+  parseWorker(&piece[0]);
+  for (i=1;i<n;i++)
+    if (started[i]) pthread_join(thread[i],NULL);
+    else parseWorker(&piece[i]);
+  /* join the lists, keeping all the nodes */
+  for (i=0;i<n;i++)
+  { Tree t = joinTree(piece[i].part,piece[i].tree);
+    freeParser(piece[i].parser);
+    if (t == NOTREE) ok = FALSE;
+    else if (ok)
+    { if (first == NOTREE) first = t;
+      else SIBLING(last) = t;
+      last = t;
+      while (SIBLING(last) != NOTREE) last = SIBLING(last);
+    }
+  }
+  return ok ? first : NOTREE;
+}
@@ -0,0 +1,33 @@
+/****************************************************/
+/* File: pparse.h                                   */
+/* Parallel parser for the C-minus compiler         */
+/****************************************************/
+
+#ifndef _PPARSE_H_
+#define _PPARSE_H_
+
+/* MINPIECE = the fewest tokens worth giving a
+ * parser thread of its own
+ */
+#define MINPIECE (1 << 18)
+
+/* MAXPARSETHREADS = the most parser threads used */
+#define MAXPARSETHREADS 64
+
+/* Function parseParallel returns the syntax tree of
+ * the whole source, scanning it into tokenArray
+ * first (see tokens.h) if need be, or NOTREE if it
+ * was not parsed. The tokens are split between
+ * top-level declarations, which end with a ; or }
+ * outside braces, and each piece is parsed as a
+ * program of its own by a parser on a thread of
+ * its own, one for each processor; the lists of
+ * declarations are then joined in order. The tree
+ * is the one parse returns. A piece with a syntax
+ * error, a source too small to split or a lack of
+ * memory gives NOTREE, without a message, and the
+ * source is to be parsed serially instead
+ */
+Tree parseParallel(void);
+
+#endif
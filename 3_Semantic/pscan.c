@@ -0,0 +1,245 @@
+/****************************************************/
+/* File: pscan.c                                    */
+/* Parallel scanner for the C-minus compiler        */
+/* A hand-written scanner for the tokens of         */
+/* cminus.l, which runs on pieces of the source     */
+/* buffer from several threads at once              */
+/****************************************************/
+
+#include "globals.h"
+#include "scan.h"
+#include "tokens.h"
+#include "pscan.h"
+#include <limits.h>
+#include <pthread.h>
+#include <unistd.h>
+
+/* TokenRun holds the tokens of one scan of a piece */
+typedef struct
+   { Token * tok;
+     int count;
+     int cap;
+     int endsInComment; /* TRUE if the piece ends inside a comment */
+   } TokenRun;
+
+/* Chunk is one piece of the source; run[0] is its
+ * scan from outside a comment, run[1] from inside
+ */
+typedef struct
+   { const char * start;
+     const char * end;
+     TokenRun run[2];
+   } Chunk;
+
+static const char * base; /* the source buffer */
+
+/* newToken returns a fresh token at the end of r */
+static Token * newToken(TokenRun * r)
+{ if (r->count == r->cap)
+  { r->cap = r->cap ? r->cap*2 : 1024;
+    r->tok = realloc(r->tok,r->cap*sizeof(Token));
+    if (r->tok == NULL)
+    { fprintf(listing,"Out of memory error scanning the source\n");
+      exit(1);
+    }
+  }
+  return &r->tok[r->count++];
+}
+
+const char * commentEnd(const char * p, const char * end)
+{ while (end - p >= 2)
+  { const char * star = memchr(p,'*',end-p-1);
+    if (star == NULL) return NULL;
+    if (star[1] == '/') return star + 2;
+    p = star + 1;
+  }
+  return NULL;
+}
+
+/* reserved returns the reserved word spelled by
+ * the len letters at s, or ID
+ */
+static TokenType reserved(const char * s, int len)
+{ switch (len)
+  { case 2: if (memcmp(s,"if",2) == 0) return IF; break;
+    case 3: if (memcmp(s,"int",3) == 0) return INT; break;
+    case 4: if (memcmp(s,"else",4) == 0) return ELSE;
+            if (memcmp(s,"void",4) == 0) return VOID; break;
+    case 5: if (memcmp(s,"while",5) == 0) return WHILE; break;
+    case 6: if (memcmp(s,"return",6) == 0) return RETURN; break;
+  }
+  return ID;
+}
+
+const char * nextToken(const char * p, const char * end,
+                       const char * buf, Token * tok, int * inComment)
+{ const char * s;
+  int c0;
+  *inComment = FALSE;
+  while (1)
+  { while (p < end && (*p == ' ' || *p == '\t' || *p == '\n')) p++;
+    if (end - p < 2 || p[0] != '/' || p[1] != '*') break;
+    p = commentEnd(p+2,end);
+    if (p == NULL)
+    { *inComment = TRUE;
+      p = end;
+      break;
+    }
+  }
+  s = p;
+  tok->val = 0;
+  tok->name = NULL;
+  if (p == end) tok->kind = ENDFILE;
+  else
+  { c0 = (unsigned char) *p++;
+    if (isalpha(c0))
+    { while (p < end && isalpha((unsigned char) *p)) p++;
+      tok->kind = reserved(s,p-s);
+    }
+    else if (isdigit(c0))
+    { int val = c0 - '0';
+      while (p < end && isdigit((unsigned char) *p))
+      { int d = *p++ - '0';
+        if (val >= 0)
+          val = val > (INT_MAX - d) / 10 ? -1 : val * 10 + d;
+      }
+      tok->kind = NUM;
+      tok->val = val;
+    }
+    else switch (c0)
+    { case '=':
+        if (p < end && *p == '=') { p++; tok->kind = EQ; }
+        else tok->kind = ASSIGN;
+        break;
+      case '!':
+        if (p < end && *p == '=') { p++; tok->kind = NE; }
+        else tok->kind = ERROR;
+        break;
+      case '<':
+        if (p < end && *p == '=') { p++; tok->kind = LE; }
+        else tok->kind = LT;
+        break;
+      case '>':
+        if (p < end && *p == '=') { p++; tok->kind = GE; }
+        else tok->kind = GT;
+        break;
+      case '/': tok->kind = OVER; break;
+      case '+': tok->kind = PLUS; break;
+      case '-': tok->kind = MINUS; break;
+      case '*': tok->kind = TIMES; break;
+      case '(': tok->kind = LPAREN; break;
+      case ')': tok->kind = RPAREN; break;
+      case '{': tok->kind = LCURLY; break;
+      case '}': tok->kind = RCURLY; break;
+      case '[': tok->kind = LBRACE; break;
+      case ']': tok->kind = RBRACE; break;
+      case ',': tok->kind = COMMA; break;
+      case ';': tok->kind = SEMI; break;
+      default: tok->kind = ERROR; break;
+    }
+  }
+  tok->span.str = s;
+  tok->span.len = p - s;
+  tok->pos = s - buf;
+  return p;
+}
+
+/* scanChunk scans the piece c into c->run[inComment] */
+static void scanChunk(Chunk * c, int inComment)
+{ TokenRun * r = &c->run[inComment];
+  const char * p = c->start;
+  const char * end = c->end;
+  r->endsInComment = FALSE;
+  if (inComment)
+  { p = commentEnd(p,end);
+    if (p == NULL)
+    { r->endsInComment = TRUE;
+      return;
+    }
+  }
+  while (1)
+  { Token * t = newToken(r);
+    p = nextToken(p,end,base,t,&r->endsInComment);
+    if (t->kind == ENDFILE)
+    { r->count--; /* the end of the piece, not of the source */
+      return;
+    }
+  }
+}
+
+/* scanWorker scans its piece both ways */
+static void * scanWorker(void * arg)
+{ Chunk * c = (Chunk *) arg;
+  scanChunk(c,FALSE);
+  scanChunk(c,TRUE);
+  return NULL;
+}
+
+void scanParallel(void)
+{ Chunk chunk[MAXSCANTHREADS];
+  pthread_t thread[MAXSCANTHREADS];
+  int started[MAXSCANTHREADS];
+  int len, n, i, k;
+  int inComment = FALSE;
+  const char * p;
+  if (tokenArray != NULL) return;
+  base = sourceText(&len);
+  n = sysconf(_SC_NPROCESSORS_ONLN);
+  if (n > len / MINCHUNK) n = len / MINCHUNK;
+  if (n > MAXSCANTHREADS) n = MAXSCANTHREADS;
+  if (n < 1) n = 1;
+  /* split the source after the newline that
+   * follows each nth part of it
+   */
+  p = base;
+  for (i=0;i<n;i++)
+  { const char * end = base + (long) len * (i+1) / n;
+    if (end < p) end = p;
+    if (i < n-1)
+    { const char * nl = memchr(end,'\n',base+len-end);
+      end = nl == NULL ? base + len : nl + 1;
+    }
+    else end = base + len;
+    chunk[i].start = p;
+    chunk[i].end = end;
+    memset(chunk[i].run,0,sizeof(chunk[i].run));
+    p = end;
+  }
+  for (i=1;i<n;i++)
+    started[i] = pthread_create(&thread[i],NULL,scanWorker,&chunk[i]) == 0;
+  scanChunk(&chunk[0],FALSE); /* the first piece starts outside a comment */
+  for (i=1;i<n;i++)
+    if (started[i]) pthread_join(thread[i],NULL);
+    else scanWorker(&chunk[i]);
+  /* join the pieces, following the comment state */
+  tokenCount = 1;
+  for (i=0;i<n;i++)
+  { TokenRun * r = &chunk[i].run[inComment];
+    tokenCount += r->count;
+    inComment = r->endsInComment;
+  }
+  tokenArray = malloc(tokenCount*sizeof(Token));
+  if (tokenArray == NULL)
+  { fprintf(listing,"Out of memory error scanning the source\n");
+    exit(1);
+  }
+  inComment = FALSE;
+  k = 0;
+  for (i=0;i<n;i++)
+  { TokenRun * r = &chunk[i].run[inComment];
+    int j;
+    for (j=0;j<r->count;j++)
+    { tokenArray[k] = r->tok[j];
+      finishToken(&tokenArray[k++]);
+    }
+    inComment = r->endsInComment;
+    free(chunk[i].run[0].tok);
+    free(chunk[i].run[1].tok);
+  }
+  tokenArray[k].kind = ENDFILE;
+  tokenArray[k].span.str = base + len;
+  tokenArray[k].span.len = 0;
+  tokenArray[k].pos = len;
+  tokenArray[k].val = 0;
+  finishToken(&tokenArray[k]);
+}
@@ -0,0 +1,46 @@
+/****************************************************/
+/* File: pscan.h                                    */
+/* Parallel scanner for the C-minus compiler        */
+/****************************************************/
+
+#ifndef _PSCAN_H_
+#define _PSCAN_H_
+
+/* MINCHUNK = the fewest source bytes worth giving
+ * a scanner thread of its own
+ */
+#define MINCHUNK (1 << 20)
+
+/* MAXSCANTHREADS = the most scanner threads used */
+#define MAXSCANTHREADS 64
+
+/* Procedure scanParallel scans the whole source
+ * into tokenArray (see tokens.h), using one thread
+ * for each processor. The source is split at line
+ * boundaries; since a comment is the only token
+ * that crosses lines, each piece is scanned both
+ * as if it started inside a comment and as if it
+ * did not, and the pieces are then joined in order,
+ * each one taking the scan that matches where the
+ * piece before it ended
+ */
+void scanParallel(void);
+
+/* Function commentEnd returns the character after
+ * the first star-slash in [p,end), or NULL if the
+ * comment does not end there
+ */
+const char * commentEnd(const char * p, const char * end);
+
+/* Function nextToken scans the first token in
+ * [p,end) of the source buf into tok, skipping
+ * blanks and comments, and returns the character
+ * after it; tok gets ENDFILE at end, with inComment
+ * set to TRUE if [p,end) ends inside a comment.
+ * The token is not finished (see finishToken in
+ * scan.h): a NUM that overflows gets val -1
+ */
+const char * nextToken(const char * p, const char * end,
+                       const char * buf, Token * tok, int * inComment);
+
+#endif
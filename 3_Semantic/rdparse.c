@@ -0,0 +1,406 @@
+/****************************************************/
+/* File: rdparse.c                                  */
+/* Recursive-descent parser for C-minus, with       */
+/* precedence climbing for expressions; it builds   */
+/* the same trees as the Yacc/Bison parser, node    */
+/* positions included. Those come from srcpos when  */
+/* a node is made, so tokens are fetched only when  */
+/* the parser must look at them, and nodes are made */
+/* where the Yacc parser reduces them               */
+/****************************************************/
+
+#include "globals.h"
+#include "util.h"
+#include "scan.h"
+#include "parse.h"
+#include "intern.h"
+#include "lines.h"
+#include <setjmp.h>
+
+static TokenType token; /* holds current token */
+static int fetched; /* TRUE if token has been fetched */
+static jmp_buf onError; /* where a syntax error ends the parse */
+static char * nullName; /* name of a void parameter list */
+
+/* function prototypes for recursive calls */
+static Tree statement(void);
+static Tree expression(void);
+
+/* peek returns the current token, fetching it */
+static TokenType peek(void)
+{ if (!fetched)
+  { token = getToken();
+    fetched = TRUE;
+  }
+  return token;
+}
+
+/* syntaxError reports the current token as the
+ * Yacc parser does, and ends the parse
+ */
+static void syntaxError(void)
+{ char * lexeme;
+  fprintf(listing,"Syntax error at line %d, column %d: %s\n",
+          lineOf(srcpos),columnOf(srcpos),"syntax error");
+  fprintf(listing,"Current token: ");
+  lexeme = copySpan(tokenSpan);
+  printToken(token,lexeme);
+  free(lexeme);
+  Error = TRUE;
+  longjmp(onError,1);
+}
+
+/* match consumes the current token, which must be
+ * expected, without fetching the next
+ */
+static void match(TokenType expected)
+{ if (peek() != expected) syntaxError();
+  fetched = FALSE;
+}
+
+/* append adds t, or its own copy if it is a shared
+ * leaf, to the list ending at *last
+ */
+static void append(Tree * first, Tree * last, Tree t)
+{ if (t == NOTREE) return;
+  t = ownLeaf(t);
+  if (*first == NOTREE) *first = t;
+  else SIBLING(*last) = t;
+  *last = t;
+}
+
+/* typeSpecifier parses int or void */
+static Tree typeSpecifier(void)
+{ Tree t;
+  if (peek() != INT && peek() != VOID) syntaxError();
+  match(token);
+  t = newTypeNode(TypeNameK);
+  ATTR(t).type = token;
+  return t;
+}
+
+/* varDeclaration parses the rest of a variable
+ * declaration after its type and name
+ */
+static Tree varDeclaration(Tree type, char * name, unsigned int pos)
+{ Tree t;
+  if (peek() == LBRACE)
+  { int size;
+    match(LBRACE);
+    if (peek() != NUM) syntaxError();
+    size = tokenValue;
+    pos = srcpos;
+    match(NUM);
+    match(RBRACE);
+    match(SEMI);
+    t = newDeclNode(ArrVarK);
+    ARRNAME(t) = name;
+    SETARRSIZE(t,size);
+  }
+  else
+  { match(SEMI);
+    t = newDeclNode(VarK);
+    ATTR(t).name = name;
+  }
+  SETCHILD(t,0,type);
+  POS(t) = pos;
+  return t;
+}
+
+/* localDeclaration parses a variable declaration */
+static Tree localDeclaration(void)
+{ Tree type = typeSpecifier();
+  char * name;
+  unsigned int pos;
+  if (peek() != ID) syntaxError();
+  name = tokenName;
+  pos = srcpos;
+  match(ID);
+  return varDeclaration(type,name,pos);
+}
+
+/* param parses a parameter after its type */
+static Tree param(Tree type)
+{ char * name;
+  Tree t;
+  if (peek() != ID) syntaxError();
+  name = tokenName;
+  match(ID);
+  if (peek() == LBRACE)
+  { match(LBRACE);
+    match(RBRACE);
+    t = newParamNode(ArrParamK);
+  }
+  else t = newParamNode(NonArrParamK);
+  SETCHILD(t,0,type);
+  ATTR(t).name = name;
+  return t;
+}
+
+/* params parses a parameter list, or void */
+static Tree params(void)
+{ Tree first = NOTREE, last = NOTREE;
+  Tree type = typeSpecifier();
+  if (peek() == RPAREN)
+  { Tree t = newParamNode(NonArrParamK);
+    SETCHILD(t,0,type);
+    ATTR(t).name = nullName;
+    return t;
+  }
+  append(&first,&last,param(type));
+  while (peek() == COMMA)
+  { match(COMMA);
+    append(&first,&last,param(typeSpecifier()));
+  }
+  return first;
+}
+
+/* compoundStmt parses { local_decls stmt_list } */
+static Tree compoundStmt(void)
+{ Tree decls = NOTREE, stmts = NOTREE, last = NOTREE;
+  Tree t;
+  match(LCURLY);
+  while (peek() == INT || peek() == VOID)
+    append(&decls,&last,localDeclaration());
+  last = NOTREE;
+  while (peek() != RCURLY)
+    append(&stmts,&last,statement());
+  match(RCURLY);
+  t = newStmtNode(CompK);
+  SETCHILD(t,0,decls);
+  SETCHILD(t,1,stmts);
+  return t;
+}
+
+/* declaration parses a variable or function
+ * declaration
+ */
+static Tree declaration(void)
+{ Tree type = typeSpecifier();
+  Tree t;
+  char * name;
+  unsigned int pos;
+  if (peek() != ID) syntaxError();
+  name = tokenName;
+  pos = srcpos;
+  match(ID);
+  if (peek() != LPAREN) return varDeclaration(type,name,pos);
+  { Tree parms, body;
+    t = newDeclNode(FuncK);
+    POS(t) = pos;
+    ATTR(t).name = name;
+    match(LPAREN);
+    parms = params();
+    match(RPAREN);
+    body = compoundStmt();
+    SETCHILD(t,0,type);
+    SETCHILD(t,1,parms);
+    SETCHILD(t,2,body);
+  }
+  return t;
+}
+
+static Tree statement(void)
+{ Tree t = NOTREE;
+  switch (peek())
+  { case LCURLY:
+      return compoundStmt();
+    case IF:
+    { Tree test, then;
+      match(IF);
+      match(LPAREN);
+      test = expression();
+      match(RPAREN);
+      then = statement();
+      if (peek() == ELSE)
+      { Tree other;
+        match(ELSE);
+        other = statement();
+        t = newStmtNode(IfEK);
+        SETCHILD(t,2,other);
+      }
+      else t = newStmtNode(IfK);
+      SETCHILD(t,0,test);
+      SETCHILD(t,1,then);
+      return t;
+    }
+    case WHILE:
+    { Tree test, body;
+      match(WHILE);
+      match(LPAREN);
+      test = expression();
+      match(RPAREN);
+      body = statement();
+      t = newStmtNode(IterK);
+      SETCHILD(t,0,test);
+      SETCHILD(t,1,body);
+      return t;
+    }
+    case RETURN:
+    { Tree value = NOTREE;
+      match(RETURN);
+      if (peek() != SEMI) value = expression();
+      match(SEMI);
+      t = newStmtNode(RetK);
+      SETCHILD(t,0,value);
+      return t;
+    }
+    case SEMI:
+      match(SEMI);
+      return NOTREE;
+    case ID: case NUM: case LPAREN:
+      t = expression();
+      match(SEMI);
+      return t;
+    default:
+      syntaxError();
+      return NOTREE;
+  }
+}
+
+/* args parses the arguments of a call */
+static Tree args(void)
+{ Tree first = NOTREE, last = NOTREE;
+  if (peek() == RPAREN) return NOTREE;
+  append(&first,&last,expression());
+  while (peek() == COMMA)
+  { match(COMMA);
+    append(&first,&last,expression());
+  }
+  return first;
+}
+
+/* idExpression parses a variable, an array element or a
+ * call, which all start with an ID
+ */
+static Tree idExpression(void)
+{ char * id = tokenName;
+  Tree t, sub;
+  match(ID);
+  switch (peek())
+  { case LBRACE:
+      t = newExpNode(ArrIdK);
+      ATTR(t).name = id;
+      match(LBRACE);
+      sub = expression();
+      match(RBRACE);
+      SETCHILD(t,0,sub);
+      return t;
+    case LPAREN:
+      t = newExpNode(CallK);
+      ATTR(t).name = id;
+      match(LPAREN);
+      sub = args();
+      match(RPAREN);
+      SETCHILD(t,0,sub);
+      return t;
+    default:
+      return newIdLeaf(id);
+  }
+}
+
+/* factor parses ( exp ), a name or a number */
+static Tree factor(void)
+{ Tree t;
+  switch (peek())
+  { case LPAREN:
+      match(LPAREN);
+      t = expression();
+      match(RPAREN);
+      return t;
+    case ID:
+      return idExpression();
+    case NUM:
+    { int val = tokenValue;
+      match(NUM);
+      return newConstLeaf(val);
+    }
+    default:
+      syntaxError();
+      return NOTREE;
+  }
+}
+
+/* the precedences of the binary operators; the
+ * comparisons do not associate
+ */
+#define CMPPREC 1
+#define ADDPREC 2
+#define MULPREC 3
+
+static int precedence(TokenType op)
+{ switch (op)
+  { case LT: case LE: case GT: case GE: case EQ: case NE: return CMPPREC;
+    case PLUS: case MINUS: return ADDPREC;
+    case TIMES: case OVER: return MULPREC;
+    default: return 0;
+  }
+}
+
+/* climb parses the operators of precedence at
+ * least min that follow the operand lhs. There is
+ * nothing above MULPREC, so the right operand of a
+ * * or / is complete without a look at the next
+ * token, and the node is made first, as the Yacc
+ * parser reduces it
+ */
+static Tree climb(Tree lhs, int min)
+{ while (precedence(peek()) >= min)
+  { TokenType op = token;
+    int prec = precedence(op);
+    Tree rhs, t;
+    match(op);
+    rhs = factor();
+    if (prec < MULPREC)
+      while (precedence(peek()) > prec)
+        rhs = climb(rhs,prec+1);
+    t = newExpNode(OpK);
+    SETCHILD(t,0,lhs);
+    SETCHILD(t,1,rhs);
+    ATTR(t).op = op;
+    lhs = t;
+    if (prec == CMPPREC) break;
+  }
+  return lhs;
+}
+
+/* expression parses an assignment or a simple
+ * expression; only a variable or an array element
+ * is assigned to
+ */
+static Tree expression(void)
+{ Tree t;
+  if (peek() != ID) return climb(factor(),CMPPREC);
+  t = idExpression();
+  if (EXPKIND(t) != CallK && peek() == ASSIGN)
+  { Tree rhs;
+    match(ASSIGN);
+    rhs = expression();
+    { Tree var = t;
+      t = newExpNode(AssignK);
+      SETCHILD(t,0,var);
+      SETCHILD(t,1,rhs);
+    }
+    return t;
+  }
+  return climb(t,CMPPREC);
+}
+
+/* Function descentParse returns the syntax tree
+ * of the tokens of getToken, or NOTREE after a
+ * syntax error; the declarations go to proc
+ * instead unless it is NULL
+ */
+Tree descentParse(DeclProc proc)
+{ Tree first = NOTREE, last = NOTREE;
+  nullName = intern("(null)",6);
+  fetched = FALSE;
+  if (setjmp(onError)) return NOTREE;
+  do
+  { Tree t = declaration();
+    if (proc == NULL) append(&first,&last,t);
+    else proc(t);
+  }
+  while (peek() != ENDFILE);
+  return first;
+}
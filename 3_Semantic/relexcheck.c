@@ -0,0 +1,153 @@
+/****************************************************/
+/* File: relexcheck.c                               */
+/* Check of incremental re-lexing (relex in         */
+/* tokens.h): makes random edits to a C-minus       */
+/* source and, after each, compares the token array */
+/* that relex keeps with a full rescan of the       */
+/* edited source                                    */
+/*                                                  */
+/* usage: relexcheck <filename> [edits [seed]]      */
+/****************************************************/
+
+#include "globals.h"
+#include "scan.h"
+#include "tokens.h"
+#include "pscan.h"
+#include <limits.h>
+
+/* allocate global variables */
+__thread unsigned int srcpos = 0;
+FILE * source;
+FILE * listing;
+FILE * code;
+
+int EchoSource = FALSE;
+ScanModeKind ScanMode = BatchScan;
+int DescentParse = FALSE;
+int ParallelParse = FALSE;
+int TraceScan = FALSE;
+int TraceParse = FALSE;
+int TraceAnalyze = FALSE;
+int TraceCode = FALSE;
+
+int Error = FALSE;
+
+/* number of edits made when none are given */
+#define EDITS 10000
+
+/* MAXDELETE = the most characters one edit deletes */
+#define MAXDELETE 4
+
+/* MAXPIECES = the most pieces one edit inserts */
+#define MAXPIECES 3
+
+/* one edit in PASTEODDS pastes a copy of the whole
+ * source, while it is shorter than PASTEMAX, so that
+ * the source outgrows its buffer and moves
+ */
+#define PASTEODDS 1024
+#define PASTEMAX (1 << 16)
+
+/* the pieces inserted are chosen to join, split
+ * and end tokens, and to open and close comments
+ */
+static char * piece[] =
+  { " ", "\n", "/*", "*/", "*", "/", "x", "int", "if", "7",
+    "=", "==", "!", "<", ">", "(", ")", ";", "{", "@" };
+
+#define PIECES (sizeof(piece) / sizeof(piece[0]))
+
+/* rescan scans the whole source again and returns
+ * the index of the first token in which it differs
+ * from tokenArray, or -1 if none does
+ */
+static int rescan(void)
+{ int len, i = 0, inComment;
+  const char * buf = sourceText(&len);
+  const char * p = buf;
+  Token t;
+  do
+  { p = nextToken(p,buf+len,buf,&t,&inComment);
+    if (t.kind == NUM && t.val < 0) t.val = INT_MAX;
+    else finishToken(&t);
+    if (i >= tokenCount ||
+        tokenArray[i].kind != t.kind ||
+        tokenArray[i].pos != t.pos ||
+        tokenArray[i].span.str != t.span.str ||
+        tokenArray[i].span.len != t.span.len ||
+        tokenArray[i].val != t.val ||
+        tokenArray[i].name != t.name)
+      return i;
+    i++;
+  } while (t.kind != ENDFILE);
+  return i == tokenCount ? -1 : i;
+}
+
+main( int argc, char * argv[] )
+{ long edits = argc > 2 ? atol(argv[2]) : EDITS;
+  long n, size;
+  int bad, len;
+  if (argc < 2 || argc > 4)
+  { fprintf(stderr,"usage: %s <filename> [edits [seed]]\n",argv[0]);
+    exit(1);
+  }
+  source = fopen(argv[1],"r");
+  if (source == NULL)
+  { fprintf(stderr,"File %s not found\n",argv[1]);
+    exit(1);
+  }
+  listing = stdout;
+  srand(argc > 3 ? atoi(argv[3]) : 1);
+  /* an edit made before the source is read */
+  fseek(source,0,SEEK_END);
+  size = ftell(source);
+  rewind(source);
+  editSource(0,0," ",1,&len);
+  if (len != size + 1)
+  { printf("%s: an edit before the first scan leaves %d of %ld characters\n",
+           argv[1],len,size+1);
+    exit(1);
+  }
+  scanAll();
+  bad = rescan();
+  if (bad >= 0)
+  { printf("%s: token %d of the first scan differs\n",argv[1],bad);
+    exit(1);
+  }
+  for (n=0;n<edits;n++)
+  { char pieces[MAXPIECES * 4 + 1];
+    char * ins = pieces;
+    int len, pos, deleted, inserted, k;
+    char * buf = sourceText(&len);
+    pos = rand() % (len + 1);
+    deleted = rand() % (MAXDELETE + 1);
+    if (deleted > len - pos) deleted = len - pos;
+    if (len < PASTEMAX && rand() % PASTEODDS == 0)
+    { /* a copy, as the source moves during the edit */
+      ins = malloc(len + 1);
+      if (ins == NULL)
+      { fprintf(stderr,"Out of memory\n");
+        exit(1);
+      }
+      memcpy(ins,buf,len);
+      ins[len] = '\0';
+    }
+    else
+    { pieces[0] = '\0';
+      for (k=rand()%(MAXPIECES+1);k>0;k--)
+        strcat(pieces,piece[rand() % PIECES]);
+    }
+    inserted = strlen(ins);
+    relex(pos,deleted,ins,inserted);
+    bad = rescan();
+    if (bad >= 0)
+    { printf("%s: edit %ld (%d deleted at %d, %d inserted):"
+             " token %d differs from a full rescan\n",
+             argv[1],n+1,deleted,pos,inserted,bad);
+      exit(1);
+    }
+    if (ins != pieces) free(ins);
+  }
+  printf("%s: %ld edits relexed as a full rescan\n",argv[1],edits);
+  return 0;
+}
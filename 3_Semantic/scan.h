@@ -8,14 +8,62 @@
 #ifndef _SCAN_H_
 #define _SCAN_H_
 
-/* MAXTOKENLEN is the maximum size of a token */
-#define MAXTOKENLEN 40
+/* Token holds one scanned token: its kind, its
+ * lexeme, its offset in the source and, for ID
+ * and NUM, its interned name or value; the value
+ * is worked out as the NUM is scanned, and one
+ * that overflows an int is reported there
+ */
+typedef struct
+   { TokenType kind;
+     TokenSpan span;
+     unsigned int pos;
+     int val;
+     char * name;
+   } Token;
+
+/* the current token, as last returned by getToken:
+ * tokenSpan locates its lexeme in the source buffer
+ * (no length limit), tokenName is the interned name
+ * (see intern.h) of an ID and tokenValue the value
+ * of a NUM; srcpos is set to its offset
+ */
+extern TokenSpan tokenSpan;
+extern char * tokenName;
+extern int tokenValue;
+
+/* function scanToken scans the next token in the
+ * source file into tok, without changing the
+ * current token; it returns the token's kind
+ */
+TokenType scanToken(Token * tok);
 
-/* tokenString array stores the lexeme of each token */
-extern char tokenString[MAXTOKENLEN+1];
+/* function sourceText returns the whole source,
+ * reading it on the first call, and sets len to
+ * its length; it is followed by two NUL characters
+ */
+char * sourceText(int * len);
+
+/* function editSource replaces the deleted
+ * characters at pos of the source with the inserted
+ * characters at ins, keeping the line index (see
+ * lines.h) up to date, and returns the source as
+ * sourceText does; the buffer may move
+ */
+char * editSource(unsigned int pos, int deleted,
+                  const char * ins, int inserted, int * len);
+
+/* Procedure finishToken completes a scanned token:
+ * it interns the name of an ID, reports a NUM
+ * whose val is -1 because it overflowed (setting
+ * val to INT_MAX) and traces the token
+ */
+void finishToken(Token * tok);
 
 /* function getToken returns the 
- * next token in source file
+ * next token in source file, taking it
+ * from the scanner as selected by ScanMode
+ * (see tokens.h)
  */
 TokenType getToken(void);
 
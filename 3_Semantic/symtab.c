@@ -1,9 +1,12 @@
 /****************************************************/
 /* File: symtab.c                                   */
 /* Symbol table implementation for the TINY compiler*/
-/* (allows only one symbol table)                   */
-/* Symbol table is implemented as a chained         */
-/* hash table                                       */
+/* Each scope hashes its symbols with open          */
+/* addressing into a table that starts empty and    */
+/* doubles as it fills; scopes, symbols, line lists */
+/* and tables are taken from two pools (arenas, see */
+/* arena.h), one for the global scope and one for   */
+/* the others, which release_scopes frees at once   */
 /* Compiler Construction: Principles and Practice   */
 /* Kenneth C. Louden                                */
 /****************************************************/
@@ -12,59 +15,79 @@
 #include <stdlib.h>
 #include <string.h>
 #include "symtab.h"
-
-/* SHIFT is the power of two used as multiplier
-   in hash function  */
-#define SHIFT 4
+#include "intern.h"
+#include "arena.h"
 
 ScopeList currentScope = NULL;
 ScopeList globalScope = NULL;
 
-/* the hash function */
+/* the last scope in the list of scopes, after which
+ * create_scope adds the next
+ */
+static ScopeList lastScope = NULL;
+
+/* the pools of the global scope and of the others */
+static Arena globalPool, localPool;
+
+/* the hash function; uses the hash stored
+   when the name was interned */
 static int hash ( char * key )
-{ int temp = 0;
-  int i = 0;
-  while (key[i] != '\0')
-  { temp = ((temp << SHIFT) + key[i]) % SIZE;
-    ++i;
+{ return internHash(key) % SIZE;
+}
+
+/* symAlloc returns size bytes from the pool of the
+ * global scope if global, else from that of the
+ * others
+ */
+static void * symAlloc(int global, unsigned int size)
+{ void * p = arenaAlloc(global ? &globalPool : &localPool, size);
+  if (p == NULL)
+  { fprintf(listing,"Out of memory error building the symbol table\n");
+    exit(1);
   }
-  return temp;
+  return p;
 }
 
 /*create new Scope*/
 ScopeList create_scope(char* name){
-    ScopeList temp = globalScope;
-    if(temp == NULL){
-        temp = (ScopeList)malloc(sizeof(struct ScopeListRec));
-        temp->name = name;
-        temp->next = NULL;
-        temp->location = 0;
-        currentScope = temp;
-        return temp;
+    ScopeList newScope = (ScopeList)symAlloc(globalScope == NULL, sizeof(struct ScopeListRec));
+    memset(newScope, 0, sizeof(struct ScopeListRec));
+    newScope->name = name;
+    if(globalScope == NULL){
+        currentScope = newScope;
     }
     else{
-        while(temp->next != NULL)
-            temp = temp->next;
-        ScopeList newScope = (ScopeList)malloc(sizeof(struct ScopeListRec));
-        newScope->name = name;
-        newScope->next = NULL;
-        newScope->location = 0;
         newScope->parent = currentScope;
-        temp->next = newScope;
-        return newScope;
+        lastScope->next = newScope;
     }
+    lastScope = newScope;
+    return newScope;
+}
+
+/* find_slot returns the slot of scope that holds
+ * name, or the empty one where it would go; the
+ * scope must have slots
+ */
+static BucketList * find_slot(ScopeList scope, char * name)
+{ unsigned int mask = scope->slotCount - 1;
+  unsigned int i = internHash(name) & mask;
+  while (scope->slot[i] != NULL && scope->slot[i]->name != name)
+    i = (i+1) & mask;
+  return &scope->slot[i];
 }
 
-/* Procedure st_insert inserts line numbers and
- * memory locations into the symbol table
- * loc = memory location is inserted only the
- * first time, otherwise ignored
+/* grow_slots doubles the slots of scope, which
+ * start at MINSLOTS
  */
-ScopeList find_scope(char* name){
-    ScopeList temp = globalScope;
-    while(strcmp(temp->name, name) != 0 && temp != NULL)
-        temp = temp->next;
-    return temp;
+static void grow_slots(ScopeList scope)
+{ int count = scope->slotCount ? scope->slotCount * 2 : MINSLOTS;
+  BucketList l;
+  /* the old slots stay in the pool until it is freed */
+  scope->slot = (BucketList *)symAlloc(scope == globalScope, count * sizeof(BucketList));
+  memset(scope->slot, 0, count * sizeof(BucketList));
+  scope->slotCount = count;
+  for (l = scope->symbols; l != NULL; l = l->next)
+    *find_slot(scope, l->name) = l;
 }
 
 /*insert bucket in scope*/
@@ -74,47 +97,41 @@ void st_insert(ScopeList scope ,char * name, ExpType type, int lineno, int loc,
     fprintf(listing, "ERROR : %s scope does not exist\n", name);
     return;
   }
-  int h = hash(name);
-  BucketList l =  target_scope->bucket[h];
-  while ((l != NULL) && (strcmp(name,l->name) != 0))
-    l = l->next;
+  BucketList l = st_lookat(target_scope, name);
   if (l == NULL) /* variable not yet in table */
-  { l = (BucketList) malloc(sizeof(struct BucketListRec));
+  { int global = target_scope == globalScope;
+    if (2 * (target_scope->symbolCount + 1) > target_scope->slotCount)
+      grow_slots(target_scope);
+    l = (BucketList) symAlloc(global, sizeof(struct BucketListRec));
     l->name = name;
-    l->lines = (LineList) malloc(sizeof(struct LineListRec));
+    l->lines = (LineList) symAlloc(global, sizeof(struct LineListRec));
     l->lines->lineno = lineno;
+    l->lines->next = NULL;
+    l->lastLine = l->lines;
     l->memloc = loc;
     l->isFunc = isFunc;
-    for(int i = 0; i < 10; i++){
-        l->params[i] = Void;
-    }
-    if(isFunc)
-        l->paramNumber = 0;
+    l->global = global;
+    l->params = NULL;
+    l->paramNumber = 0;
+    l->paramCount = 0;
     l->type = type;
-    l->lines->next = NULL;
-    l->next = NULL;
-    target_scope->bucket[h] = l; }
+    l->next = target_scope->symbols;
+    target_scope->symbols = l;
+    target_scope->symbolCount++;
+    *find_slot(target_scope, name) = l; }
   else /* found in table, so just add line number */
-  { LineList t = l->lines;
-    while (t->next != NULL) t = t->next;
-    t->next = (LineList) malloc(sizeof(struct LineListRec));
-    t->next->lineno = lineno;
-    t->next->next = NULL;
-  }
+    add_line(l, lineno);
 } /* st_insert */
 
-/* Function st_lookup returns the memory 
- * location of a variable or -1 if not found
+/* Procedure add_line appends lineno to the lines of
+ * bucket
  */
 void add_line(BucketList bucket ,int lineno){
-    LineList l = bucket->lines;
-    while(l->next != NULL)
-        l = l->next;
-    LineList temp = (LineList)malloc(sizeof(struct LineListRec));
+    LineList temp = (LineList)symAlloc(bucket->global, sizeof(struct LineListRec));
     temp->lineno = lineno;
     temp->next = NULL;
-    l->next = temp;
-
+    bucket->lastLine->next = temp;
+    bucket->lastLine = temp;
 }
 
 BucketList st_lookup (ScopeList scope, char * name )
@@ -123,17 +140,13 @@ BucketList st_lookup (ScopeList scope, char * name )
     fprintf(listing, "ERROR : %s scope does not exist\n", name);
     return NULL;
   }
-  int h = hash(name);
   while(target_scope != NULL){
-    BucketList l =  target_scope->bucket[h];
-    while ((l != NULL) && (strcmp(name,l->name) != 0))
-        l = l->next;
+    BucketList l = st_lookat(target_scope, name);
     if (l != NULL)
         return l;
     target_scope = target_scope->parent;
   }
-  if(target_scope == NULL)
-      return NULL;
+  return NULL;
 }
 
 BucketList st_lookat (ScopeList scope, char * name ){
@@ -142,17 +155,113 @@ BucketList st_lookat (ScopeList scope, char * name ){
     fprintf(listing, "ERROR : %s scope does not exist\n", name);
     return NULL;
   }
-  int h = hash(name);
-  BucketList l =  target_scope->bucket[h];
-  while ((l != NULL) && (strcmp(name,l->name) != 0))
-      l = l->next;
-  return l;
+  if(target_scope->slotCount == 0)
+      return NULL;
+  return *find_slot(target_scope, name);
 }
 
 void insertFuncParam(char* func, ExpType type){
     BucketList bucket = st_lookat(globalScope, func);
+    if(bucket->paramNumber == bucket->paramCount){
+        int count = bucket->paramCount ? bucket->paramCount * 2 : MINPARAMS;
+        ExpType * params = (ExpType *)symAlloc(bucket->global, count * sizeof(ExpType));
+        if(bucket->paramNumber > 0)
+            memcpy(params, bucket->params, bucket->paramNumber * sizeof(ExpType));
+        bucket->params = params;
+        bucket->paramCount = count;
+    }
     bucket->params[bucket->paramNumber++] = type;
 }
+/* the rows of the scopes freed by release_scopes,
+ * kept for printSymTab in a temporary file
+ */
+static FILE * releasedRows = NULL;
+
+/* printRow prints the row of one symbol of scope */
+static void printRow(FILE * listing, ScopeList scope, BucketList bucket)
+{
+    fprintf(listing, "%s              ", bucket->name);
+    if(bucket->isFunc == 1)
+        fprintf(listing, "Function");
+    else{
+        if(bucket->type == Integer)
+            fprintf(listing, "    Integer");
+        else if(bucket->type == IntegerArray)
+            fprintf(listing, "IntegerArray");
+        else
+            fprintf(listing, "Void");
+    }
+    fprintf(listing, "     %s     %d            ", scope->name, bucket->memloc);
+    LineList line = bucket->lines;
+    while(line != NULL){
+        fprintf(listing, "%d ", line->lineno);
+        line = line->next;
+    }
+    fprintf(listing, "     ");
+    for(int i = 0; i < bucket->paramNumber; i++){
+        if(bucket->params[i] == Integer){
+            fprintf(listing, "int, ");
+        }
+        else if(bucket->params[i] == IntegerArray){
+            fprintf(listing, "intArr, ");
+        }
+        else{
+        }
+    }
+    if(scope->parent != NULL){
+        fprintf(listing, "    %s", scope->parent->name);
+    }
+    fprintf(listing, "\n");
+}
+
+/* printScope prints the rows of one scope, ordered
+ * by hash modulo SIZE and the latest first among
+ * equal hashes, as when each scope was a chained
+ * table of SIZE buckets
+ */
+static void printScope(FILE * listing, ScopeList scope)
+{
+    int start[SIZE+1];
+    BucketList bucket;
+    BucketList * rows;
+    if(scope->symbolCount == 0)
+        return;
+    rows = (BucketList *)malloc(scope->symbolCount * sizeof(BucketList));
+    if(rows == NULL){ /* in the order of insertion, the latest first */
+        for(bucket = scope->symbols; bucket != NULL; bucket = bucket->next)
+            printRow(listing, scope, bucket);
+        return;
+    }
+    /* a counting sort, which keeps the symbols' order
+       among equal hashes */
+    memset(start, 0, sizeof(start));
+    for(bucket = scope->symbols; bucket != NULL; bucket = bucket->next)
+        start[hash(bucket->name)+1]++;
+    for(int i = 1; i <= SIZE; i++)
+        start[i] += start[i-1];
+    for(bucket = scope->symbols; bucket != NULL; bucket = bucket->next)
+        rows[start[hash(bucket->name)]++] = bucket;
+    for(int i = 0; i < scope->symbolCount; i++)
+        printRow(listing, scope, rows[i]);
+    free(rows);
+}
+
+void release_scopes(void)
+{
+    if(globalScope->next == NULL)
+        return;
+    if(releasedRows == NULL && (releasedRows = tmpfile()) == NULL)
+        return; /* they are kept and listed as usual */
+    ScopeList scope;
+    /* all are listed before any is freed, as a row
+       shows the name of its scope's parent */
+    for(scope = globalScope->next; scope != NULL; scope = scope->next)
+        printScope(releasedRows, scope);
+    globalScope->next = NULL;
+    lastScope = globalScope;
+    arenaRelease(&localPool);
+}
+
 /* Procedure printSymTab prints a formatted 
  * listing of the symbol table contents 
  * to the listing file
@@ -161,49 +270,17 @@ void printSymTab(FILE * listing)
 {   fprintf(listing,"Variable Name  Variable Type  Scope Name  Location   Line Numbers   params   parentScope\n");
     fprintf(listing,"-------------  -------------  ----------  --------   ------------   ------   -----------\n");
     ScopeList scope = globalScope;
-    while(scope != NULL){
-        for(int i = 0; i < SIZE; i++){
-            if(scope->bucket[i] == NULL){
-                continue;
-            }
-            BucketList bucket = scope->bucket[i];
-            while(bucket != NULL){
-                fprintf(listing, "%s              ", bucket->name);
-                if(bucket->isFunc == 1)
-                    fprintf(listing, "Function");
-                else{
-                    if(bucket->type == Integer)
-                        fprintf(listing, "    Integer");
-                    else if(bucket->type == IntegerArray)
-                        fprintf(listing, "IntegerArray");
-                    else
-                        fprintf(listing, "Void");
-                }
-                fprintf(listing, "     %s     %d            ", scope->name, bucket->memloc);
-                LineList line = bucket->lines;
-                while(line != NULL){
-                    fprintf(listing, "%d ", line->lineno);
-                    line = line->next;
-                }
-                fprintf(listing, "     ");
-                for(int i = 0; i < bucket->paramNumber; i++){
-                    if(bucket->params[i] == Integer){
-                        fprintf(listing, "int, ");
-                    }
-                    else if(bucket->params[i] == IntegerArray){
-                        fprintf(listing, "intArr, ");
-                    }
-                    else{
-                    }
-                }
-                if(scope->parent != NULL){
-                    fprintf(listing, "    %s", scope->parent->name);
-                }
-                fprintf(listing, "\n");
-                bucket = bucket->next;
-            }
-        }
-        scope = scope->next;
+    if(scope == NULL)
+        return;
+    printScope(listing, scope);
+    if(releasedRows != NULL){ /* the scopes that came after */
+        char buf[4096];
+        size_t n;
+        rewind(releasedRows);
+        while((n = fread(buf, 1, sizeof(buf), releasedRows)) > 0)
+            fwrite(buf, 1, n, listing);
     }
+    for(scope = scope->next; scope != NULL; scope = scope->next)
+        printScope(listing, scope);
 }
 /* printSymTab */
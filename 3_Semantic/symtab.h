@@ -9,8 +9,18 @@
 #ifndef _SYMTAB_H_
 #define _SYMTAB_H_
 
+/* SIZE orders the rows of the listing (see
+ * printScope in symtab.c)
+ */
 #define SIZE 211
-#define MAX_SCOPES 1000
+
+/* MINSLOTS = the slots of a scope's table once it
+ * has a symbol, and MINPARAMS those of a function's
+ * parameter types once it has one (both double as
+ * needed)
+ */
+#define MINSLOTS 4
+#define MINPARAMS 4
 
 #include "globals.h"
 /* the list of line numbers of the source 
@@ -31,20 +41,29 @@ typedef struct BucketListRec
    { char * name;
      ExpType type;
      LineList lines;
+     LineList lastLine; /* where add_line appends */
      int memloc ; /* memory location for variable */
      int isFunc;
-     struct BucketListRec * next;
-     ExpType params[10];
+     int global; /* in the global scope */
+     struct BucketListRec * next; /* inserted before, in its scope */
+     ExpType * params; /* of a function, paramCount of them */
      int paramNumber;
+     int paramCount;
    } * BucketList;
 
 /* The record for each scope,
- * including name, its bucket,
- * and parent scope
+ * including name, its symbols,
+ * and parent scope; the symbols are
+ * hashed into slotCount slots (none
+ * until the first), at most half of
+ * them in use
 */
 typedef struct ScopeListRec
     { char* name;
-      BucketList bucket[SIZE];
+      BucketList * slot;
+      int slotCount;
+      int symbolCount;
+      BucketList symbols; /* the latest inserted */
       struct ScopeListRec* next;
       struct ScopeListRec* parent;
       int location;
@@ -59,11 +78,18 @@ typedef struct ScopeListRec
  * memory locations into the symbol table
  * loc = memory location is inserted only the
  * first time, otherwise ignored
+ * Variable and function names passed to the
+ * st_ functions must be interned (see intern.h);
+ * they are compared by pointer
  */
 void st_insert(ScopeList scope, char * name, ExpType type, int lineno, int loc, int isFunc );
 
+/* Function create_scope makes a scope inside the
+ * current one, adding it to the list of scopes;
+ * the analyzer keeps each scope of a compound
+ * statement on its CompK, to enter it again
+ */
 ScopeList create_scope(char* name);
-ScopeList find_scope(char* name);
 /* Function st_lookup returns BucketList 
  *
  */
@@ -72,6 +98,12 @@ BucketList st_lookup(ScopeList scope, char * name );
 BucketList st_lookat(ScopeList scope, char* name);
 BucketList st_lookup_excluding_parent(ScopeList* scope, char* name);
 void insertFuncParam(char* func, ExpType type);
+/* Procedure release_scopes frees the scopes but
+ * the global one, none of which may be in use any
+ * more; their rows of the symbol table listing are
+ * kept for printSymTab, in a temporary file
+ */
+void release_scopes(void);
 /* Procedure printSymTab prints a formatted 
  * listing of the symbol table contents 
  * to the listing file
@@ -0,0 +1,214 @@
+/****************************************************/
+/* File: tokens.c                                   */
+/* Token stream between the scanner and the parser  */
+/* for the C-minus compiler: tokens are taken from  */
+/* the scanner one at a time (StreamScan), from an  */
+/* array holding the whole source (BatchScan), from */
+/* a single-producer/single-consumer ring filled by */
+/* a scanner thread (ThreadScan), or from an array  */
+/* filled by several threads (ParallelScan)         */
+/****************************************************/
+
+#include "globals.h"
+#include "scan.h"
+#include "tokens.h"
+#include "lines.h"
+#include "pscan.h"
+#include <pthread.h>
+#include <sched.h>
+
+/* the current token (see scan.h) */
+TokenSpan tokenSpan;
+char * tokenName;
+int tokenValue;
+
+Token * tokenArray = NULL;
+int tokenCount = 0;
+static int tokenCap = 0;
+static int tokenNext = 0; /* next token of tokenArray for the parser */
+static int ended = FALSE; /* no tokens past ENDFILE */
+
+void scanAll(void)
+{ if (tokenArray != NULL) return;
+  do
+  { if (tokenCount == tokenCap)
+    { Token * t;
+      tokenCap = tokenCap ? tokenCap*2 : 4096;
+      t = realloc(tokenArray,tokenCap*sizeof(Token));
+      if (t == NULL)
+      { fprintf(listing,"Out of memory error at line %d\n",lineOf(srcpos));
+        exit(1);
+      }
+      tokenArray = t;
+    }
+    scanToken(&tokenArray[tokenCount]);
+  } while (tokenArray[tokenCount++].kind != ENDFILE);
+}
+
+/* RINGSIZE = number of tokens in the ring (a power of two) */
+#define RINGSIZE 4096
+
+static Token ring[RINGSIZE];
+static unsigned int ringHead = 0; /* count of tokens put by the scanner */
+static unsigned int ringTail = 0; /* count of tokens taken by the parser */
+static int ringStop = FALSE; /* tells the scanner thread to give up */
+static int threadState = 0; /* 0 = not started, 1 = running, -1 = failed */
+static pthread_t scanThread;
+
+/* scanLoop is the scanner thread: it scans tokens
+ * into the ring until ENDFILE, waiting while the
+ * ring is full
+ */
+static void * scanLoop(void * arg)
+{ unsigned int head = 0;
+  Token tok;
+  do
+  { scanToken(&tok);
+    while (head - __atomic_load_n(&ringTail,__ATOMIC_ACQUIRE) == RINGSIZE)
+    { if (__atomic_load_n(&ringStop,__ATOMIC_ACQUIRE)) return NULL;
+      sched_yield();
+    }
+    ring[head % RINGSIZE] = tok;
+    __atomic_store_n(&ringHead,++head,__ATOMIC_RELEASE);
+  } while (tok.kind != ENDFILE);
+  return NULL;
+}
+
+/* ringGet takes the next token out of the ring,
+ * waiting for the scanner thread if it is empty
+ */
+static void ringGet(Token * tok)
+{ while (__atomic_load_n(&ringHead,__ATOMIC_ACQUIRE) == ringTail)
+    sched_yield();
+  *tok = ring[ringTail % RINGSIZE];
+  __atomic_store_n(&ringTail,ringTail+1,__ATOMIC_RELEASE);
+}
+
+void endTokens(void)
+{ if (threadState == 1)
+  { __atomic_store_n(&ringStop,TRUE,__ATOMIC_RELEASE);
+    pthread_join(scanThread,NULL);
+    threadState = 0;
+  }
+}
+
+/* function getToken returns the
+ * next token in source file
+ */
+TokenType getToken(void)
+{ static Token tok;
+  if (!ended)
+  { if (ScanMode == BatchScan)
+    { if (tokenArray == NULL) scanAll();
+      tok = tokenArray[tokenNext++];
+    }
+    else if (ScanMode == ParallelScan)
+    { if (tokenArray == NULL) scanParallel();
+      tok = tokenArray[tokenNext++];
+    }
+    else if (ScanMode == ThreadScan)
+    { if (threadState == 0)
+        threadState = pthread_create(&scanThread,NULL,scanLoop,NULL) ? -1 : 1;
+      if (threadState == 1) ringGet(&tok);
+      else scanToken(&tok); /* no thread: scan in line */
+    }
+    else scanToken(&tok);
+    ended = (tok.kind == ENDFILE);
+  }
+  tokenSpan = tok.span;
+  tokenName = tok.name;
+  tokenValue = tok.val;
+  srcpos = tok.pos;
+  return tok.kind;
+}
+
+/* firstAfter returns the first token of tokenArray
+ * that ends at or after pos
+ */
+static int firstAfter(unsigned int pos)
+{ int lo = 0, hi = tokenCount - 1; /* ENDFILE ends last */
+  while (lo < hi)
+  { int mid = (lo + hi) / 2;
+    if (tokenArray[mid].pos + tokenArray[mid].span.len >= pos) hi = mid;
+    else lo = mid + 1;
+  }
+  return lo;
+}
+
+void relex(unsigned int pos, int deleted, const char * ins, int inserted)
+{ Token * fresh = NULL; /* the tokens scanned again */
+  int freshCount = 0, freshCap = 0;
+  int first, next, count, len, i;
+  int shift = inserted - deleted;
+  unsigned int from;
+  const char * p;
+  char * old, * buf;
+  if (tokenArray == NULL) scanAll();
+  old = sourceText(&len);
+  /* tokens that end before pos cannot change, nor
+   * can the scanner's state after the last of them
+   */
+  first = firstAfter(pos);
+  from = first > 0 ? tokenArray[first-1].pos + tokenArray[first-1].span.len : 0;
+  buf = editSource(pos,deleted,ins,inserted,&len);
+  /* scan from there until a token starts, past the
+   * inserted text, where an old token now starts
+   */
+  next = first;
+  p = buf + from;
+  while (1)
+  { Token t;
+    int inComment;
+    p = nextToken(p,buf+len,buf,&t,&inComment);
+    if (t.pos >= pos + inserted)
+    { while (next < tokenCount &&
+             (tokenArray[next].pos < pos + deleted ||
+              tokenArray[next].pos + shift < t.pos))
+        next++;
+      if (next < tokenCount && tokenArray[next].pos + shift == t.pos)
+        break;
+    }
+    if (freshCount == freshCap)
+    { freshCap = freshCap ? freshCap*2 : 64;
+      fresh = realloc(fresh,freshCap*sizeof(Token));
+      if (fresh == NULL)
+      { fprintf(listing,"Out of memory error scanning the source\n");
+        exit(1);
+      }
+    }
+    fresh[freshCount++] = t;
+    if (t.kind == ENDFILE)
+    { next = tokenCount;
+      break;
+    }
+  }
+  /* splice the new tokens in, shifting the rest */
+  count = first + freshCount + (tokenCount - next);
+  if (count > tokenCap)
+  { Token * t;
+    tokenCap = count > 2*tokenCap ? count : 2*tokenCap;
+    t = realloc(tokenArray,tokenCap*sizeof(Token));
+    if (t == NULL)
+    { fprintf(listing,"Out of memory error scanning the source\n");
+      exit(1);
+    }
+    tokenArray = t;
+  }
+  memmove(tokenArray + first + freshCount,tokenArray + next,
+          (tokenCount - next) * sizeof(Token));
+  for (i=first+freshCount;i<count;i++)
+  { tokenArray[i].pos += shift;
+    tokenArray[i].span.str = buf + tokenArray[i].pos;
+  }
+  if (buf != old)
+    for (i=0;i<first;i++)
+      tokenArray[i].span.str = buf + tokenArray[i].pos;
+  for (i=0;i<freshCount;i++)
+  { tokenArray[first+i] = fresh[i];
+    finishToken(&tokenArray[first+i]);
+  }
+  free(fresh);
+  tokenCount = count;
+  tokenNext = 0;
+  ended = FALSE;
+}
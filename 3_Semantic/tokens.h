@@ -0,0 +1,41 @@
+/****************************************************/
+/* File: tokens.h                                   */
+/* Token stream between the scanner and the parser  */
+/* for the C-minus compiler                         */
+/****************************************************/
+
+#ifndef _TOKENS_H_
+#define _TOKENS_H_
+
+/* tokenArray holds the tokenCount tokens of the
+ * whole source once it has been scanned in
+ * BatchScan or ParallelScan mode; the last one
+ * is ENDFILE
+ */
+extern Token * tokenArray;
+extern int tokenCount;
+
+/* Procedure scanAll scans the whole source into
+ * tokenArray
+ */
+void scanAll(void);
+
+/* Procedure relex brings tokenArray up to date
+ * after the deleted characters at pos of the source
+ * are replaced with the inserted characters at ins
+ * (see editSource in scan.h). Only the tokens from
+ * the last one ending before pos up to the first
+ * one after the edit that starts where an old token
+ * did are scanned again; the rest are kept, shifted.
+ * The parser then takes tokens from the start again;
+ * this is for the BatchScan and ParallelScan modes
+ */
+void relex(unsigned int pos, int deleted, const char * ins, int inserted);
+
+/* Procedure endTokens stops the scanner thread
+ * in ThreadScan mode, once the parser needs no
+ * more tokens
+ */
+void endTokens(void);
+
+#endif
@@ -0,0 +1,376 @@
+/****************************************************/
+/* File: treecache.c                                */
+/* On-disk cache of syntax trees                    */
+/* A cache file is named after the FNV-1a hash and  */
+/* the length of the source. It holds a header, the */
+/* names of the tree (NUL terminated, padded to a   */
+/* multiple of four bytes) and a fixed              */
+/* size record per node, in preorder: a node comes  */
+/* before its children, which come before its next  */
+/* sibling. The file is mapped and the tree is      */
+/* rebuilt from it with the usual constructors      */
+/****************************************************/
+
+#include "globals.h"
+#include "util.h"
+#include "scan.h"
+#include "intern.h"
+#include "treecache.h"
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* change TREEVERSION with the file layout */
+#define TREEMAGIC 0x544d4343u /* "CCMT" */
+#define TREEVERSION 1
+
+/* no name */
+#define NONAME 0xffffffffu
+
+/* flags of a node record: which children follow
+ * it, and whether a sibling follows them
+ */
+#define HASCHILD(i) (1 << (i))
+#define HASSIBLING (1 << MAXCHILDREN)
+
+typedef struct
+   { uint32_t magic;
+     uint32_t version;
+     uint64_t hash;
+     uint32_t srclen;
+     uint32_t nnames;
+     uint32_t namebytes;
+     uint32_t nnodes;
+   } TreeHeader;
+
+/* a is the name, value, operator or type of the
+ * node, and b the size of an ArrVarK
+ */
+typedef struct
+   { uint8_t nodekind;
+     uint8_t kind;
+     uint8_t flags;
+     uint8_t pad;
+     uint32_t pos;
+     uint32_t a;
+     uint32_t b;
+   } TreeRecord;
+
+/* the number of kinds of each node kind, and the
+ * children a node of each kind may have
+ */
+static const int kindCount[] = {5,6,3,2,1};
+static const unsigned char maxKids[5][6] =
+   { /* StmtK */ {2,3,2,2,1},
+     /* ExpK */ {2,2,0,0,1,1},
+     /* DeclK */ {1,3,1},
+     /* ParamK */ {1,1},
+     /* TypeK */ {0} };
+
+/* cachePath sets path to the cache file in dir for
+ * the current source, returning FALSE if it is
+ * too long; the hash is computed once
+ */
+static uint64_t sourceHash;
+static int sourceLen = -1;
+
+static int cachePath(char * path, int size, char * dir)
+{ if (sourceLen < 0)
+  { const unsigned char * s = (const unsigned char *) sourceText(&sourceLen);
+    uint64_t h = 14695981039346656037ull;
+    int i;
+    for (i=0;i<sourceLen;i++)
+    { h ^= s[i];
+      h *= 1099511628211ull;
+    }
+    sourceHash = h;
+  }
+  return snprintf(path,size,"%s/%016llx-%d.ast",dir,
+                  (unsigned long long) sourceHash,sourceLen) < size;
+}
+
+/* hasName tells whether nodes of the given kinds
+ * hold a name
+ */
+static int hasName(int nodekind, int kind)
+{ return nodekind == DeclK || nodekind == ParamK ||
+         (nodekind == ExpK && (kind == IdK || kind == ArrIdK || kind == CallK));
+}
+
+/* makeNode makes the node of record r, whose names
+ * are in names, returning NOTREE if r is not valid
+ */
+static Tree makeNode(TreeRecord * r, char ** names, uint32_t nnames)
+{ Tree t;
+  int i;
+  if (r->nodekind > TypeK || r->kind >= kindCount[r->nodekind])
+    return NOTREE;
+  for (i=0;i<MAXCHILDREN;i++)
+    if ((r->flags & HASCHILD(i)) && i >= maxKids[r->nodekind][r->kind])
+      return NOTREE;
+  switch (r->nodekind)
+  { case StmtK: t = newStmtNode(r->kind); break;
+    case ExpK: t = newExpNode(r->kind); break;
+    case DeclK: t = newDeclNode(r->kind); break;
+    case ParamK: t = newParamNode(r->kind); break;
+    default: t = newTypeNode(r->kind); break;
+  }
+  if (t == NOTREE) return NOTREE;
+  POS(t) = r->pos;
+  if (hasName(r->nodekind,r->kind))
+  { char * name;
+    if (r->a == NONAME) name = NULL;
+    else if (r->a < nnames) name = names[r->a];
+    else return NOTREE;
+    if (r->nodekind == DeclK && r->kind == ArrVarK)
+    { ARRNAME(t) = name;
+      SETARRSIZE(t,(int) r->b);
+    }
+    else ATTR(t).name = name;
+  }
+  else if (r->nodekind == ExpK && r->kind == OpK) ATTR(t).op = r->a;
+  else if (r->nodekind == ExpK && r->kind == ConstK) ATTR(t).val = r->a;
+  else if (r->nodekind == TypeK) ATTR(t).type = r->a;
+  return t;
+}
+
+/* a slot still to be filled while rebuilding: the
+ * child which of parent, or its sibling if which
+ * is MAXCHILDREN
+ */
+typedef struct
+   { Tree parent;
+     int which;
+   } Slot;
+
+/* buildTree rebuilds the tree from the nnodes
+ * records at rec; it returns NOTREE if they do not
+ * make exactly one tree
+ */
+static Tree buildTree(TreeRecord * rec, uint32_t nnodes,
+                      char ** names, uint32_t nnames)
+{ Slot * stack = malloc((3*(size_t)nnodes+1) * sizeof(Slot));
+  int top = 0;
+  uint32_t n;
+  Tree root = NOTREE;
+  if (stack == NULL) return NOTREE;
+  stack[top].parent = NOTREE; /* the root */
+  stack[top++].which = 0;
+  for (n=0;n<nnodes && top > 0;n++)
+  { Slot s = stack[--top];
+    Tree t = makeNode(&rec[n],names,nnames);
+    int i;
+    if (t == NOTREE) break;
+    if (s.parent == NOTREE) root = t;
+    else if (s.which == MAXCHILDREN) SIBLING(s.parent) = t;
+    else SETCHILD(s.parent,s.which,t);
+    if (rec[n].flags & HASSIBLING)
+    { stack[top].parent = t;
+      stack[top++].which = MAXCHILDREN;
+    }
+    for (i=MAXCHILDREN-1;i>=0;i--)
+      if (rec[n].flags & HASCHILD(i))
+      { stack[top].parent = t;
+        stack[top++].which = i;
+      }
+  }
+  if (n < nnodes || top > 0) root = NOTREE;
+  free(stack);
+  return root;
+}
+
+Tree loadTree( char * dir )
+{ char path[1024];
+  struct stat st;
+  TreeHeader * h;
+  char * map;
+  char ** names;
+  char * s;
+  uint32_t i;
+  Tree t = NOTREE;
+  int fd;
+  if (!cachePath(path,sizeof(path),dir)) return NOTREE;
+  fd = open(path,O_RDONLY);
+  if (fd < 0) return NOTREE;
+  if (fstat(fd,&st) < 0 || st.st_size < sizeof(TreeHeader))
+  { close(fd);
+    return NOTREE;
+  }
+  map = mmap(NULL,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+  close(fd);
+  if (map == MAP_FAILED) return NOTREE;
+  h = (TreeHeader *) map;
+  if (h->magic != TREEMAGIC || h->version != TREEVERSION ||
+      h->hash != sourceHash || h->srclen != sourceLen ||
+      st.st_size != sizeof(TreeHeader) + (off_t) h->namebytes
+                    + (off_t) h->nnodes * sizeof(TreeRecord) ||
+      h->namebytes % sizeof(uint32_t) != 0 ||
+      (names = malloc(((size_t)h->nnames+1) * sizeof(char *))) == NULL)
+  { munmap(map,st.st_size);
+    return NOTREE;
+  }
+  s = map + sizeof(TreeHeader);
+  for (i=0;i<h->nnames;i++)
+  { char * end = memchr(s,'\0',map + sizeof(TreeHeader) + h->namebytes - s);
+    if (end == NULL) break;
+    names[i] = intern(s,end-s);
+    s = end+1;
+  }
+  if (i == h->nnames)
+    t = buildTree((TreeRecord *)(map + sizeof(TreeHeader) + h->namebytes),
+                  h->nnodes,names,h->nnames);
+  free(names);
+  munmap(map,st.st_size);
+  return t;
+}
+
+/* the names of the tree being saved, each given
+ * its index in the file by a hash table keyed by
+ * the interned name
+ */
+typedef struct
+   { char * name;
+     uint32_t index;
+   } NameSlot;
+
+static NameSlot * nameTable;
+static uint32_t nameTableSize;
+static uint32_t nameCount;
+static char * nameBytes;
+static uint32_t nameLen, nameCap;
+static int nameFailed; /* out of memory for the names */
+
+/* nameIndex returns the index of name, adding it */
+static uint32_t nameIndex(char * name)
+{ uint32_t h;
+  int len;
+  if (name == NULL) return NONAME;
+  h = internHash(name) & (nameTableSize-1);
+  while (nameTable[h].name != NULL && nameTable[h].name != name)
+    h = (h+1) & (nameTableSize-1);
+  if (nameTable[h].name != NULL) return nameTable[h].index;
+  len = strlen(name) + 1;
+  if (nameLen + len > nameCap)
+  { char * p;
+    while (nameLen + len > nameCap) nameCap *= 2;
+    p = realloc(nameBytes,nameCap);
+    if (p == NULL)
+    { nameFailed = TRUE;
+      return NONAME;
+    }
+    nameBytes = p;
+  }
+  memcpy(nameBytes+nameLen,name,len);
+  nameLen += len;
+  nameTable[h].name = name;
+  return nameTable[h].index = nameCount++;
+}
+
+void saveTree( char * dir, Tree tree )
+{ char path[1024], temp[1040];
+  TreeHeader h;
+  TreeRecord * rec = NULL;
+  Tree * stack = NULL;
+  uint32_t n = 0, cap = 1024, top = 0;
+  FILE * f;
+  int ok;
+  if (tree == NOTREE || !cachePath(path,sizeof(path),dir)) return;
+  nameTableSize = 1024;
+  nameCount = nameLen = 0;
+  nameFailed = FALSE;
+  nameCap = 4096;
+  nameTable = calloc(nameTableSize,sizeof(NameSlot));
+  nameBytes = malloc(nameCap);
+  rec = malloc(cap * sizeof(TreeRecord));
+  stack = malloc(cap * sizeof(Tree));
+  ok = nameTable != NULL && nameBytes != NULL && rec != NULL && stack != NULL;
+  if (ok) stack[top++] = tree;
+  while (ok && top > 0)
+  { Tree t = stack[--top];
+    TreeRecord * r;
+    int i;
+    if (n == cap || top + MAXCHILDREN + 1 > cap)
+    { void * p = realloc(rec,2 * cap * sizeof(TreeRecord));
+      void * q = p ? realloc(stack,2 * cap * sizeof(Tree)) : NULL;
+      if (p) rec = p;
+      if (q) stack = q;
+      if (!(ok = p != NULL && q != NULL)) break;
+      cap *= 2;
+    }
+    if (2 * nameCount >= nameTableSize) /* rehash at half full */
+    { NameSlot * old = nameTable;
+      uint32_t j, oldSize = nameTableSize;
+      nameTable = calloc(nameTableSize *= 2,sizeof(NameSlot));
+      if (!(ok = nameTable != NULL))
+      { nameTable = old;
+        break;
+      }
+      for (j=0;j<oldSize;j++)
+        if (old[j].name != NULL)
+        { uint32_t k = internHash(old[j].name) & (nameTableSize-1);
+          while (nameTable[k].name != NULL) k = (k+1) & (nameTableSize-1);
+          nameTable[k] = old[j];
+        }
+      free(old);
+    }
+    r = &rec[n++];
+    memset(r,0,sizeof(TreeRecord));
+    r->nodekind = NODEKIND(t);
+    r->kind = NODEKIND(t) == StmtK ? STMTKIND(t) :
+              NODEKIND(t) == ExpK ? EXPKIND(t) :
+              NODEKIND(t) == DeclK ? DECLKIND(t) :
+              NODEKIND(t) == ParamK ? PARAMKIND(t) : TYPEKIND(t);
+    r->pos = POS(t);
+    if (NODEKIND(t) == DeclK && DECLKIND(t) == ArrVarK)
+    { r->a = nameIndex(ARRNAME(t));
+      r->b = ARRSIZE(t);
+    }
+    else if (hasName(r->nodekind,r->kind))
+      r->a = nameIndex(ATTR(t).name);
+    else if (NODEKIND(t) == ExpK && EXPKIND(t) == OpK) r->a = ATTR(t).op;
+    else if (NODEKIND(t) == ExpK && EXPKIND(t) == ConstK) r->a = ATTR(t).val;
+    else if (NODEKIND(t) == TypeK) r->a = ATTR(t).type;
+    ok = !nameFailed;
+    if (SIBLING(t) != NOTREE)
+    { r->flags |= HASSIBLING;
+      stack[top++] = SIBLING(t);
+    }
+    for (i=MAXCHILDREN-1;i>=0;i--)
+      if (CHILD(t,i) != NOTREE)
+      { r->flags |= HASCHILD(i);
+        stack[top++] = CHILD(t,i);
+      }
+  }
+  while (ok && nameLen % sizeof(uint32_t) != 0) /* align the records */
+  { if (nameLen == nameCap)
+      ok = (nameBytes = realloc(nameBytes,nameCap *= 2)) != NULL;
+    if (ok) nameBytes[nameLen++] = '\0';
+  }
+  if (ok)
+  { h.magic = TREEMAGIC;
+    h.version = TREEVERSION;
+    h.hash = sourceHash;
+    h.srclen = sourceLen;
+    h.nnames = nameCount;
+    h.namebytes = nameLen;
+    h.nnodes = n;
+    mkdir(dir,0777);
+    /* written aside and renamed, so that a reader
+       never sees a partial file */
+    snprintf(temp,sizeof(temp),"%s.%d",path,(int) getpid());
+    f = fopen(temp,"wb");
+    if (f != NULL)
+    { ok = fwrite(&h,sizeof(h),1,f) == 1 &&
+           fwrite(nameBytes,1,nameLen,f) == nameLen &&
+           fwrite(rec,sizeof(TreeRecord),n,f) == n;
+      if (fclose(f) == 0 && ok) rename(temp,path);
+      else remove(temp);
+    }
+  }
+  free(nameTable);
+  free(nameBytes);
+  free(rec);
+  free(stack);
+}
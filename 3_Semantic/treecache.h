@@ -0,0 +1,24 @@
+/****************************************************/
+/* File: treecache.h                                */
+/* On-disk cache of syntax trees for the C-minus    */
+/* compiler, keyed by a hash of the source text     */
+/****************************************************/
+
+#ifndef _TREECACHE_H_
+#define _TREECACHE_H_
+
+/* Function loadTree returns the syntax tree that
+ * saveTree stored in the directory dir for the
+ * current source (see sourceText in scan.h), or
+ * NOTREE if there is none; the source then need
+ * not be scanned and parsed
+ */
+Tree loadTree( char * dir );
+
+/* Procedure saveTree stores tree, parsed without
+ * error from the current source, in the directory
+ * dir, creating it if need be
+ */
+void saveTree( char * dir, Tree tree );
+
+#endif
@@ -8,6 +8,25 @@
 
 #include "globals.h"
 #include "util.h"
+#include "lines.h"
+#include "arena.h"
+#include "ast.h"
+#include "intern.h"
+
+/* the strings, and unless COMPACT_AST the nodes,
+ * of the syntax tree, made by each thread
+ */
+static __thread Arena treeArena;
+
+/* a TreePart holds what a thread has made of the
+ * syntax tree
+ */
+struct TreePartRec
+   { Arena arena;
+#if COMPACT_AST
+     AstPart ast;
+#endif
+   };
 
 /* Procedure printToken prints a token 
  * and its lexeme to the listing file
@@ -60,102 +79,284 @@ void printToken( TokenType token, const char* tokenString )
   }
 }
 
-/* Function newStmtNode creates a new statement
- * node for syntax tree construction
+/* newNode makes a node of the given kinds at the
+ * current source position, with no children
  */
-TreeNode * newStmtNode(StmtKind kind)
-{ TreeNode * t = (TreeNode *) malloc(sizeof(TreeNode));
+static Tree newNode(NodeKind nodekind, int kind)
+{
+#if COMPACT_AST
+  Tree t = astNew(nodekind,kind);
+  if (t==NOTREE)
+    fprintf(listing,"Out of memory error at line %d\n",lineOf(srcpos));
+  else
+    POS(t) = srcpos;
+#else
+  TreeNode * t = (TreeNode *) arenaAlloc(&treeArena,sizeof(TreeNode));
   int i;
   if (t==NULL)
-    fprintf(listing,"Out of memory error at line %d\n",lineno);
+    fprintf(listing,"Out of memory error at line %d\n",lineOf(srcpos));
   else {
     for (i=0;i<MAXCHILDREN;i++) t->child[i] = NULL;
     t->sibling = NULL;
-    t->nodekind = StmtK;
-    t->kind.stmt = kind;
-    t->lineno = lineno;
+    t->nodekind = nodekind;
+    switch (nodekind)
+    { case StmtK: t->kind.stmt = kind; break;
+      case ExpK: t->kind.exp = kind; break;
+      case DeclK: t->kind.decl = kind; break;
+      case ParamK: t->kind.param = kind; break;
+      case TypeK: t->kind.type = kind; break;
+    }
+    t->pos = srcpos;
+    t->type = Void;
   }
+#endif
   return t;
 }
 
+/* Function newStmtNode creates a new statement
+ * node for syntax tree construction
+ */
+Tree newStmtNode(StmtKind kind)
+{ return newNode(StmtK,kind); }
+
 /* Function newExpNode creates a new expression 
  * node for syntax tree construction
  */
-TreeNode * newExpNode(ExpKind kind)
-{ TreeNode * t = (TreeNode *) malloc(sizeof(TreeNode));
-  int i;
-  if (t==NULL)
-    fprintf(listing,"Out of memory error at line %d\n",lineno);
-  else {
-    for (i=0;i<MAXCHILDREN;i++) t->child[i] = NULL;
-    t->sibling = NULL;
-    t->nodekind = ExpK;
-    t->kind.exp = kind;
-    t->lineno = lineno;
-    t->type = Void;
+Tree newExpNode(ExpKind kind)
+{ return newNode(ExpK,kind); }
+
+Tree newDeclNode(DeclKind kind)
+{ return newNode(DeclK,kind); }
+
+Tree newParamNode(ParamKind kind)
+{ return newNode(ParamK,kind); }
+
+Tree newTypeNode(TypeKind kind)
+{ return newNode(TypeK,kind); }
+
+#if HASH_CONS
+
+/* LeafSlot holds a shared leaf, with its key: the
+ * value of a ConstK, or the name and line of an IdK
+ * (the line being what the analyzer reports of it)
+ */
+typedef struct
+   { Tree leaf; /* NOTREE in an empty slot */
+     int val;
+     char * name;
+     int line;
+   } LeafSlot;
+
+/* LeafTable hashes shared leaves with open
+ * addressing into cap slots, at most half of them
+ * in use. Only leaves of one line are kept: a slot
+ * of another line is free, so that the names of a
+ * line are forgotten as the parser leaves it
+ */
+typedef struct
+   { LeafSlot * slot;
+     unsigned int count, cap;
+     int line;
+   } LeafTable;
+
+/* the shared leaves made by each thread: constants
+ * (all of line 0), and names of the current line
+ */
+static __thread LeafTable constLeaves, idLeaves;
+
+static unsigned int leafHash(LeafSlot * key)
+{ unsigned int h = key->name == NULL ? (unsigned int) key->val
+                   : internHash(key->name) * 31 + key->line;
+  /* runs of values and of lines would cluster in
+   * the low bits, so those are mixed with the high
+   */
+  h ^= h >> 16;
+  h *= 0x45d9f3bu;
+  h ^= h >> 16;
+  return h;
+}
+
+#define SLOTUSED(tab,s) ((s)->leaf != NOTREE && (s)->line == (tab)->line)
+
+/* findLeaf returns the slot of tab holding the leaf
+ * for key, or the free slot where it belongs, making
+ * room first; or NULL if out of memory
+ */
+static LeafSlot * findLeaf(LeafTable * tab, LeafSlot * key)
+{ LeafSlot * s;
+  if (key->line != tab->line)
+  { tab->line = key->line;
+    tab->count = 0;
   }
-  return t;
+  if (2 * (tab->count + 1) > tab->cap)
+  { unsigned int cap = tab->cap ? tab->cap * 2 : 64;
+    LeafSlot * slot = calloc(cap,sizeof(LeafSlot));
+    unsigned int i, j;
+    if (slot == NULL) return NULL;
+    for (i=0;i<tab->cap;i++)
+      if (SLOTUSED(tab,&tab->slot[i]))
+      { j = leafHash(&tab->slot[i]) & (cap-1);
+        while (slot[j].leaf != NOTREE) j = (j+1) & (cap-1);
+        slot[j] = tab->slot[i];
+      }
+    free(tab->slot);
+    tab->slot = slot;
+    tab->cap = cap;
+  }
+  s = &tab->slot[leafHash(key) & (tab->cap-1)];
+  while (SLOTUSED(tab,s) &&
+         (s->val != key->val || s->name != key->name))
+    s = s == &tab->slot[tab->cap-1] ? tab->slot : s+1;
+  return s;
 }
 
-TreeNode * newDeclNode(DeclKind kind)
-{ TreeNode * t = (TreeNode *) malloc(sizeof(TreeNode));
-  int i;
-  if (t==NULL)
-    fprintf(listing,"Out of memory error at line %d\n",lineno);
-  else {
-    for (i=0;i<MAXCHILDREN;i++) t->child[i] = NULL;
-    t->sibling = NULL;
-    t->nodekind = DeclK;
-    t->kind.decl = kind;
-    t->lineno = lineno;
+/* forgetLeaves empties the tables of shared leaves,
+ * whose nodes are no longer the thread's
+ */
+static void forgetLeaves(void)
+{ free(constLeaves.slot);
+  free(idLeaves.slot);
+  memset(&constLeaves,0,sizeof(constLeaves));
+  memset(&idLeaves,0,sizeof(idLeaves));
+}
+
+/* shareLeaf returns the leaf of tab for key, making
+ * it if there is none
+ */
+static Tree shareLeaf(LeafTable * tab, LeafSlot * key)
+{ LeafSlot * s = findLeaf(tab,key);
+  Tree t;
+  if (s != NULL && SLOTUSED(tab,s)) return s->leaf;
+  t = newExpNode(key->name == NULL ? ConstK : IdK);
+  if (t == NOTREE) return NOTREE;
+  if (key->name == NULL) ATTR(t).val = key->val;
+  else ATTR(t).name = key->name;
+  if (s != NULL)
+  { *s = *key;
+    s->leaf = t;
+    tab->count++;
   }
   return t;
 }
 
-TreeNode * newParamNode(ParamKind kind)
-{ TreeNode * t = (TreeNode *) malloc(sizeof(TreeNode));
-  int i;
-  if (t==NULL)
-    fprintf(listing,"Out of memory error at line %d\n",lineno);
-  else {
-    for (i=0;i<MAXCHILDREN;i++) t->child[i] = NULL;
-    t->sibling = NULL;
-    t->nodekind = ParamK;
-    t->kind.param = kind;
-    t->lineno = lineno;
-  }
+#endif
+
+Tree newConstLeaf(int val)
+{
+#if HASH_CONS
+  LeafSlot key;
+  key.val = val;
+  key.name = NULL;
+  key.line = 0;
+  return shareLeaf(&constLeaves,&key);
+#else
+  Tree t = newExpNode(ConstK);
+  if (t != NOTREE) ATTR(t).val = val;
   return t;
+#endif
 }
 
-TreeNode * newTypeNode(TypeKind kind)
-{ TreeNode * t = (TreeNode *) malloc(sizeof(TreeNode));
-  int i;
-  if (t==NULL)
-    fprintf(listing,"Out of memory error at line %d\n",lineno);
-  else {
-    for (i=0;i<MAXCHILDREN;i++) t->child[i] = NULL;
-    t->sibling = NULL;
-    t->nodekind = TypeK;
-    t->kind.type = kind;
-    t->lineno = lineno;
-  }
+Tree newIdLeaf(char * name)
+{
+#if HASH_CONS
+  LeafSlot key;
+  key.val = 0;
+  key.name = name;
+  key.line = lineOf(srcpos);
+  return shareLeaf(&idLeaves,&key);
+#else
+  Tree t = newExpNode(IdK);
+  if (t != NOTREE) ATTR(t).name = name;
   return t;
+#endif
 }
+
+Tree ownLeaf(Tree t)
+{
+#if HASH_CONS
+  Tree c;
+  if (t == NOTREE || NODEKIND(t) != ExpK ||
+      (EXPKIND(t) != ConstK && EXPKIND(t) != IdK))
+    return t;
+  c = newExpNode(EXPKIND(t));
+  if (c == NOTREE) return t;
+  POS(c) = POS(t);
+  ATTR(c) = ATTR(t);
+  return c;
+#else
+  return t;
+#endif
+}
+
 /* Function copyString allocates and makes a new
- * copy of an existing string
+ * copy of an existing string, which lives as long
+ * as the syntax tree
  */
 char * copyString(char * s)
 { int n;
   char * t;
   if (s==NULL) return NULL;
   n = strlen(s)+1;
-  t = malloc(n);
+  t = arenaAlloc(&treeArena,n);
   if (t==NULL)
-    fprintf(listing,"Out of memory error at line %d\n",lineno);
+    fprintf(listing,"Out of memory error at line %d\n",lineOf(srcpos));
   else strcpy(t,s);
   return t;
 }
 
+/* Procedure releaseTree frees all the nodes made
+ * by the functions above and the copies made by
+ * copyString
+ */
+void releaseTree(void)
+{
+#if COMPACT_AST
+  astRelease();
+#endif
+  arenaRelease(&treeArena);
+#if HASH_CONS
+  forgetLeaves();
+#endif
+}
+
+TreePart takeTree(void)
+{ TreePart part = malloc(sizeof(struct TreePartRec));
+  if (part == NULL) return NULL;
+  part->arena = treeArena;
+  memset(&treeArena,0,sizeof(treeArena));
+#if COMPACT_AST
+  astTake(&part->ast);
+#endif
+#if HASH_CONS
+  forgetLeaves();
+#endif
+  return part;
+}
+
+Tree joinTree(TreePart part, Tree t)
+{ if (part == NULL) return NOTREE;
+  arenaMerge(&treeArena,&part->arena);
+#if COMPACT_AST
+  t = astJoin(&part->ast,t);
+#endif
+  free(part);
+  return t;
+}
+
+/* Function copySpan allocates a NUL terminated
+ * copy of a lexeme in the source buffer
+ */
+char * copySpan(TokenSpan s)
+{ char * t = malloc(s.len+1);
+  if (t==NULL)
+    fprintf(listing,"Out of memory error at line %d\n",lineOf(srcpos));
+  else
+  { memcpy(t,s.str,s.len);
+    t[s.len] = '\0';
+  }
+  return t;
+}
+
 /* Variable indentno is used by printTree to
  * store current number of spaces to indent
  */
@@ -172,114 +373,169 @@ static void printSpaces(void)
     fprintf(listing," ");
 }
 
-/* procedure printTree prints a syntax tree to the 
- * listing file using indentation to indicate subtrees
+/* a node whose children walkTree is visiting, and
+ * the next child to visit
  */
-void printTree( TreeNode * tree )
-{ int i;
-  INDENT;
-  while (tree != NULL) {
-    printSpaces();
-    if (tree->nodekind==StmtK)
-    { switch (tree->kind.stmt) {
-        case IfK:
-          fprintf(listing,"If (condition) (body)\n");
-          break;
-        case IterK:
-          fprintf(listing,"Repeat\n");
-          break;
-        case CompK:
-          fprintf(listing,"Compound statement :\n");
-          break;
-        case IfEK:
-          fprintf(listing,"If (condition) (body) else\n");
-          break;
-        case RetK:
-          fprintf(listing,"Return :\n");
-          break;
-        default:
-          fprintf(listing,"Unknown ExpNode kind\n");
-          break;
+typedef struct
+   { Tree t;
+     int next;
+   } WalkFrame;
+
+void walkTree( Tree t, void (* preProc) (Tree),
+               void (* postProc) (Tree) )
+{ int size = 64, top = 0;
+  WalkFrame * stack;
+  if (t == NOTREE) return;
+  stack = malloc(size * sizeof(WalkFrame));
+  if (stack == NULL) goto nomemory;
+  preProc(t);
+  stack[top].t = t;
+  stack[top++].next = 0;
+  while (top > 0)
+  { WalkFrame * f = &stack[top-1];
+    Tree c = NOTREE;
+    while (c == NOTREE && f->next < MAXCHILDREN)
+    { c = CHILD(f->t,f->next);
+      f->next++;
+    }
+    if (c == NOTREE) /* the children are done */
+    { postProc(f->t);
+      c = SIBLING(f->t); /* takes the place of f */
+      top--;
+    }
+    if (c != NOTREE)
+    { if (top == size)
+      { WalkFrame * p = realloc(stack,2 * size * sizeof(WalkFrame));
+        if (p == NULL) goto nomemory;
+        stack = p;
+        size *= 2;
       }
+      preProc(c);
+      stack[top].t = c;
+      stack[top++].next = 0;
     }
-    else if (tree->nodekind==ExpK)
-    { switch (tree->kind.exp) {
-        case OpK:
-          fprintf(listing,"Op: ");
-          printToken(tree->attr.op,"\0");
-          break;
-        case ConstK:
-          fprintf(listing,"Const: %d\n",tree->attr.val);
-          break;
-        case IdK:
-          fprintf(listing,"Id: %s\n",tree->attr.name);
+  }
+  free(stack);
+  return;
+nomemory:
+  fprintf(listing,"Out of memory error walking the syntax tree\n");
+  exit(1);
+}
+
+/* printNode prints one node of the tree, and
+ * indents for its children
+ */
+static void printNode( Tree tree )
+{ printSpaces();
+  if (NODEKIND(tree)==StmtK)
+  { switch (STMTKIND(tree)) {
+      case IfK:
+        fprintf(listing,"If (condition) (body)\n");
+        break;
+      case IterK:
+        fprintf(listing,"Repeat\n");
+        break;
+      case CompK:
+        fprintf(listing,"Compound statement :\n");
+        break;
+      case IfEK:
+        fprintf(listing,"If (condition) (body) else\n");
+        break;
+      case RetK:
+        fprintf(listing,"Return :\n");
+        break;
+      default:
+        fprintf(listing,"Unknown ExpNode kind\n");
+        break;
+    }
+  }
+  else if (NODEKIND(tree)==ExpK)
+  { switch (EXPKIND(tree)) {
+      case OpK:
+        fprintf(listing,"Op: ");
+        printToken(ATTR(tree).op,"\0");
+        break;
+      case ConstK:
+        fprintf(listing,"Const: %d\n",ATTR(tree).val);
+        break;
+      case IdK:
+        fprintf(listing,"Id: %s\n",ATTR(tree).name);
+        break;
+      case AssignK:
+        fprintf(listing,"Assign : (destination) (source)\n");
+        break;
+      case ArrIdK:
+        fprintf(listing,"ArrId: %s\n",ATTR(tree).name);
+        break;
+      case CallK:
+        fprintf(listing,"Call name: %s, with arguments below\n", ATTR(tree).name);
+        break;
+      default:
+        fprintf(listing,"Unknown ExpNode kind\n");
+        break;
+    }
+  }
+  else if (NODEKIND(tree)==DeclK)
+  { switch (DECLKIND(tree)) {
+      case FuncK:
+          fprintf(listing, "Function declaration, name : %s, return ", ATTR(tree).name);
           break;
-        case AssignK:
-          fprintf(listing,"Assign : (destination) (source)\n");
+      case VarK:
+          fprintf(listing, "Var declaration, name : %s, ", ATTR(tree).name);
           break;
-        case ArrIdK:
-          fprintf(listing,"ArrId: %s\n",tree->attr.name);
+      case ArrVarK:
+          fprintf(listing, "ArrVar declaration, name : %s, size : %d, ", ARRNAME(tree), ARRSIZE(tree));
           break;
-        case CallK:
-          fprintf(listing,"Call name: %s, with arguments below\n", tree->attr.name);
+      default:
+        fprintf(listing,"Unknown DeclNode kind\n");
+        break;
+                                   
+    }
+  }
+  else if (NODEKIND(tree)==ParamK)
+  { switch (PARAMKIND(tree)) {
+      case ArrParamK:
+          fprintf(listing, "Array parameter, name : %s, ", ATTR(tree).name);
           break;
-        default:
-          fprintf(listing,"Unknown ExpNode kind\n");
+      case NonArrParamK:
+          fprintf(listing, "Single parameter, name : %s, ", ATTR(tree).name);
           break;
-      }
+      default:
+        fprintf(listing,"Unknown ParamNode kind\n");
+        break;                    
     }
-    else if (tree->nodekind==DeclK)
-    { switch (tree->kind.decl) {
-        case FuncK:
-            fprintf(listing, "Function declaration, name : %s, return ", tree->attr.name);
-            break;
-        case VarK:
-            fprintf(listing, "Var declaration, name : %s, ", tree->attr.name);
-            break;
-        case ArrVarK:
-            fprintf(listing, "ArrVar declaration, name : %s, size : %d, ", tree->attr.arr.name, tree->attr.arr.size);
-            break;
-        default:
-          fprintf(listing,"Unknown DeclNode kind\n");
+  }
+  else if (NODEKIND(tree)==TypeK)
+  { switch (TYPEKIND(tree)) {
+      case TypeNameK:
+          fprintf(listing,"type : ");
+          switch(ATTR(tree).type){
+              case INT:
+                  fprintf(listing, "int\n");
+                  break;
+              case VOID:
+                  fprintf(listing, "void\n");
+                  break;
+          }
           break;
-                                     
-      }
-    }
-    else if (tree->nodekind==ParamK)
-    { switch (tree->kind.param) {
-        case ArrParamK:
-            fprintf(listing, "Array parameter, name : %s, ", tree->attr.name);
-            break;
-        case NonArrParamK:
-            fprintf(listing, "Single parameter, name : %s, ", tree->attr.name);
-            break;
-        default:
-          fprintf(listing,"Unknown ParamNode kind\n");
-          break;                    
-      }
-    }
-    else if (tree->nodekind==TypeK)
-    { switch (tree->kind.type) {
-        case TypeNameK:
-            fprintf(listing,"type : ");
-            switch(tree->attr.type){
-                case INT:
-                    fprintf(listing, "int\n");
-                    break;
-                case VOID:
-                    fprintf(listing, "void\n");
-                    break;
-            }
-            break;
-        default:
-          fprintf(listing,"Unknown TypeNode kind\n");
-          break;                    
-      }
+      default:
+        fprintf(listing,"Unknown TypeNode kind\n");
+        break;                    
     }
-    else fprintf(listing,"Unknown node kind\n");
-    for (i=0;i<MAXCHILDREN;i++)
-         printTree(tree->child[i]);
-    tree = tree->sibling;
   }
+  else fprintf(listing,"Unknown node kind\n");
+  INDENT;
+}
+
+/* unindent comes back from the children of a node */
+static void unindent( Tree tree )
+{ UNINDENT; }
+
+/* procedure printTree prints a syntax tree to the 
+ * listing file using indentation to indicate subtrees
+ */
+void printTree( Tree tree )
+{ INDENT;
+  walkTree(tree,printNode,unindent);
   UNINDENT;
 }
@@ -16,26 +16,87 @@ void printToken( TokenType, const char* );
 /* Function newStmtNode creates a new statement
  * node for syntax tree construction
  */
-TreeNode * newStmtNode(StmtKind);
+Tree newStmtNode(StmtKind);
 
 /* Function newExpNode creates a new expression 
  * node for syntax tree construction
  */
-TreeNode * newExpNode(ExpKind);
+Tree newExpNode(ExpKind);
 
-TreeNode* newDeclNode(DeclKind);
+Tree newDeclNode(DeclKind);
 
-TreeNode* newParamNode(ParamKind);
+Tree newParamNode(ParamKind);
+
+Tree newTypeNode(TypeKind);
+
+/* Functions newConstLeaf and newIdLeaf return an
+ * expression node for a constant or a name. With
+ * HASH_CONS, alike leaves are made once and then
+ * shared: a ConstK by value, and an IdK by name and
+ * source line, as the analyzer reports each use of
+ * a name by line. A shared leaf holds nothing that
+ * differs between its uses; the analyzer looks up
+ * the type of each use of a name instead
+ */
+Tree newConstLeaf(int val);
+Tree newIdLeaf(char * name);
+
+/* Function ownLeaf returns t, or with HASH_CONS a
+ * copy of it if it is a leaf that may be shared; a
+ * node is passed through it before it is given a
+ * sibling
+ */
+Tree ownLeaf(Tree t);
 
-TreeNode* newTypeNode(TypeKind);
 /* Function copyString allocates and makes a new
- * copy of an existing string
+ * copy of an existing string, which lives as long
+ * as the syntax tree
  */
 char * copyString( char * );
 
+/* Procedure releaseTree frees all the syntax tree
+ * nodes and copyString copies of the calling
+ * thread (see joinTree) at once, at the end of a
+ * compilation
+ */
+void releaseTree( void );
+
+/* a TreePart holds the nodes that a thread other
+ * than the main one has made
+ */
+typedef struct TreePartRec * TreePart;
+
+/* Function takeTree returns all the nodes the
+ * calling thread has made, for joinTree, or NULL
+ * if out of memory
+ */
+TreePart takeTree( void );
+
+/* Function joinTree adds the nodes of part to
+ * those of the calling thread, to be released with
+ * them, and frees part; it returns the node t of
+ * part as it is known there, or NOTREE if that
+ * fails
+ */
+Tree joinTree( TreePart part, Tree t );
+
+/* Function copySpan allocates a NUL terminated
+ * copy of a lexeme in the source buffer
+ */
+char * copySpan( TokenSpan );
+
+/* Procedure walkTree applies preProc in preorder
+ * and postProc in postorder to each node of the tree
+ * t and of the trees of its siblings. It keeps its
+ * own stack, as deep as the nesting of the tree, so
+ * long sibling lists take no extra space
+ */
+void walkTree( Tree t, void (* preProc) (Tree),
+               void (* postProc) (Tree) );
+
 /* procedure printTree prints a syntax tree to the 
  * listing file using indentation to indicate subtrees
  */
-void printTree( TreeNode * );
+void printTree( Tree );
 
 #endif
@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,29 +45,29 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.4"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
-#define YYPUSH 0
+#define YYPUSH 1
 
 /* Pull parsers.  */
-#define YYPULL 1
+#define YYPULL 0
 
 
 
 
-/* Copy the first part of user declarations.  */
-#line 7 "cminus.y" /* yacc.c:339  */
+/* First part of user prologue.  */
+#line 7 "cminus.y"
 
 #define YYPARSER /* distinguishes Yacc output from other code files */
 
@@ -70,35 +75,93 @@
 #include "util.h"
 #include "scan.h"
 #include "parse.h"
+#include "intern.h"
+#include "tokens.h"
+#include "lines.h"
+#include "pparse.h"
+
+#define YYSTYPE Tree
 
-#define YYSTYPE TreeNode *
-static char * savedName; /* for use in assignments */
-static int savedNumber;
-static int savedLineNo;  /* ditto */
-static TreeNode * savedTree; /* stores syntax tree for later return */
-static int yylex(void); // added 11/2/11 to ensure no conflict with lex
+/* the state of a parse beyond Bison's own, which is
+ * in ps: tokens are pushed into it (see parse.h)
+ */
+struct ParserRec
+   { struct yypstate * ps;
+     Token tok; /* the last token pushed */
+     char * savedName; /* for use in assignments */
+     int savedNumber;
+     unsigned int savedPos;  /* ditto */
+     Tree savedTree; /* stores syntax tree for later return */
+     char * nullName; /* name of a void parameter list */
+     int status; /* of the last yypush_parse */
+     DeclProc declProc; /* takes the declarations, if set */
+     int muted; /* TRUE if syntax errors are not reported */
+   };
+
+static int yyerror(Parser p, char * message);
+
+/* lists of siblings are built circularly while they
+ * are parsed: a list is kept as its last node, whose
+ * sibling is the first, so that appendList takes
+ * constant time (a shared leaf is copied first, see
+ * ownLeaf); closeList turns the finished list into
+ * the usual one, returning its first node
+ */
+static Tree appendList(Tree last, Tree t)
+{ if (t == NOTREE) return last;
+  t = ownLeaf(t);
+  if (last == NOTREE) SIBLING(t) = t;
+  else
+  { SIBLING(t) = SIBLING(last);
+    SIBLING(last) = t;
+  }
+  return t;
+}
 
+static Tree closeList(Tree last)
+{ Tree first;
+  if (last == NOTREE) return NOTREE;
+  first = SIBLING(last);
+  SIBLING(last) = NOTREE;
+  return first;
+}
 
-#line 83 "y.tab.c" /* yacc.c:339  */
+/* addDecl appends the top-level declaration t to
+ * the list ending at last, or hands it to the
+ * parser's declProc, leaving the list empty
+ */
+static Tree addDecl(Parser p, Tree last, Tree t)
+{ if (p->declProc == NULL) return appendList(last,t);
+  p->declProc(t);
+  return NOTREE;
+}
 
+
+#line 141 "y.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "y.tab.h".  */
+/* Use api.header.include to #include this header
+   instead of duplicating it here.  */
 #ifndef YY_YY_Y_TAB_H_INCLUDED
 # define YY_YY_Y_TAB_H_INCLUDED
 /* Debug traces.  */
@@ -108,73 +171,53 @@ static int yylex(void); // added 11/2/11 to ensure no conflict with lex
 #if YYDEBUG
 extern int yydebug;
 #endif
+/* "%code requires" blocks.  */
+#line 79 "cminus.y"
+ struct ParserRec; 
+
+#line 179 "y.tab.c"
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    IF = 258,
-    ELSE = 259,
-    WHILE = 260,
-    RETURN = 261,
-    INT = 262,
-    VOID = 263,
-    ID = 264,
-    NUM = 265,
-    EQ = 266,
-    NE = 267,
-    LT = 268,
-    LE = 269,
-    GT = 270,
-    GE = 271,
-    ASSIGN = 272,
-    PLUS = 273,
-    MINUS = 274,
-    TIMES = 275,
-    OVER = 276,
-    LPAREN = 277,
-    RPAREN = 278,
-    LBRACE = 279,
-    RBRACE = 280,
-    LCURLY = 281,
-    RCURLY = 282,
-    SEMI = 283,
-    COMMA = 284,
-    ERROR = 285,
-    NO_ELSE = 286
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    IF = 258,                      /* IF  */
+    ELSE = 259,                    /* ELSE  */
+    WHILE = 260,                   /* WHILE  */
+    RETURN = 261,                  /* RETURN  */
+    INT = 262,                     /* INT  */
+    VOID = 263,                    /* VOID  */
+    ID = 264,                      /* ID  */
+    NUM = 265,                     /* NUM  */
+    EQ = 266,                      /* EQ  */
+    NE = 267,                      /* NE  */
+    LT = 268,                      /* LT  */
+    LE = 269,                      /* LE  */
+    GT = 270,                      /* GT  */
+    GE = 271,                      /* GE  */
+    ASSIGN = 272,                  /* ASSIGN  */
+    PLUS = 273,                    /* PLUS  */
+    MINUS = 274,                   /* MINUS  */
+    TIMES = 275,                   /* TIMES  */
+    OVER = 276,                    /* OVER  */
+    LPAREN = 277,                  /* LPAREN  */
+    RPAREN = 278,                  /* RPAREN  */
+    LBRACE = 279,                  /* LBRACE  */
+    RBRACE = 280,                  /* RBRACE  */
+    LCURLY = 281,                  /* LCURLY  */
+    RCURLY = 282,                  /* RCURLY  */
+    SEMI = 283,                    /* SEMI  */
+    COMMA = 284,                   /* COMMA  */
+    ERROR = 285,                   /* ERROR  */
+    NO_ELSE = 286                  /* NO_ELSE  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
-#define IF 258
-#define ELSE 259
-#define WHILE 260
-#define RETURN 261
-#define INT 262
-#define VOID 263
-#define ID 264
-#define NUM 265
-#define EQ 266
-#define NE 267
-#define LT 268
-#define LE 269
-#define GT 270
-#define GE 271
-#define ASSIGN 272
-#define PLUS 273
-#define MINUS 274
-#define TIMES 275
-#define OVER 276
-#define LPAREN 277
-#define RPAREN 278
-#define LBRACE 279
-#define RBRACE 280
-#define LCURLY 281
-#define RCURLY 282
-#define SEMI 283
-#define COMMA 284
-#define ERROR 285
-#define NO_ELSE 286
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
@@ -184,42 +227,183 @@ typedef int YYSTYPE;
 #endif
 
 
-extern YYSTYPE yylval;
 
-int yyparse (void);
+
+#ifndef YYPUSH_MORE_DEFINED
+# define YYPUSH_MORE_DEFINED
+enum { YYPUSH_MORE = 4 };
+#endif
+
+typedef struct yypstate yypstate;
+
+
+int yypush_parse (yypstate *ps,
+                  int pushed_char, YYSTYPE const *pushed_val, struct ParserRec * p);
+
+yypstate *yypstate_new (void);
+void yypstate_delete (yypstate *ps);
+
 
 #endif /* !YY_YY_Y_TAB_H_INCLUDED  */
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_IF = 3,                         /* IF  */
+  YYSYMBOL_ELSE = 4,                       /* ELSE  */
+  YYSYMBOL_WHILE = 5,                      /* WHILE  */
+  YYSYMBOL_RETURN = 6,                     /* RETURN  */
+  YYSYMBOL_INT = 7,                        /* INT  */
+  YYSYMBOL_VOID = 8,                       /* VOID  */
+  YYSYMBOL_ID = 9,                         /* ID  */
+  YYSYMBOL_NUM = 10,                       /* NUM  */
+  YYSYMBOL_EQ = 11,                        /* EQ  */
+  YYSYMBOL_NE = 12,                        /* NE  */
+  YYSYMBOL_LT = 13,                        /* LT  */
+  YYSYMBOL_LE = 14,                        /* LE  */
+  YYSYMBOL_GT = 15,                        /* GT  */
+  YYSYMBOL_GE = 16,                        /* GE  */
+  YYSYMBOL_ASSIGN = 17,                    /* ASSIGN  */
+  YYSYMBOL_PLUS = 18,                      /* PLUS  */
+  YYSYMBOL_MINUS = 19,                     /* MINUS  */
+  YYSYMBOL_TIMES = 20,                     /* TIMES  */
+  YYSYMBOL_OVER = 21,                      /* OVER  */
+  YYSYMBOL_LPAREN = 22,                    /* LPAREN  */
+  YYSYMBOL_RPAREN = 23,                    /* RPAREN  */
+  YYSYMBOL_LBRACE = 24,                    /* LBRACE  */
+  YYSYMBOL_RBRACE = 25,                    /* RBRACE  */
+  YYSYMBOL_LCURLY = 26,                    /* LCURLY  */
+  YYSYMBOL_RCURLY = 27,                    /* RCURLY  */
+  YYSYMBOL_SEMI = 28,                      /* SEMI  */
+  YYSYMBOL_COMMA = 29,                     /* COMMA  */
+  YYSYMBOL_ERROR = 30,                     /* ERROR  */
+  YYSYMBOL_NO_ELSE = 31,                   /* NO_ELSE  */
+  YYSYMBOL_YYACCEPT = 32,                  /* $accept  */
+  YYSYMBOL_program = 33,                   /* program  */
+  YYSYMBOL_decl_list = 34,                 /* decl_list  */
+  YYSYMBOL_decl = 35,                      /* decl  */
+  YYSYMBOL_saveName = 36,                  /* saveName  */
+  YYSYMBOL_saveNumber = 37,                /* saveNumber  */
+  YYSYMBOL_var_decl = 38,                  /* var_decl  */
+  YYSYMBOL_type_spec = 39,                 /* type_spec  */
+  YYSYMBOL_fun_decl = 40,                  /* fun_decl  */
+  YYSYMBOL_41_1 = 41,                      /* @1  */
+  YYSYMBOL_params = 42,                    /* params  */
+  YYSYMBOL_param_list = 43,                /* param_list  */
+  YYSYMBOL_param = 44,                     /* param  */
+  YYSYMBOL_comp_stmt = 45,                 /* comp_stmt  */
+  YYSYMBOL_local_decls = 46,               /* local_decls  */
+  YYSYMBOL_stmt_list = 47,                 /* stmt_list  */
+  YYSYMBOL_stmt = 48,                      /* stmt  */
+  YYSYMBOL_exp_stmt = 49,                  /* exp_stmt  */
+  YYSYMBOL_sel_stmt = 50,                  /* sel_stmt  */
+  YYSYMBOL_iter_stmt = 51,                 /* iter_stmt  */
+  YYSYMBOL_ret_stmt = 52,                  /* ret_stmt  */
+  YYSYMBOL_exp = 53,                       /* exp  */
+  YYSYMBOL_var = 54,                       /* var  */
+  YYSYMBOL_55_2 = 55,                      /* @2  */
+  YYSYMBOL_simple_exp = 56,                /* simple_exp  */
+  YYSYMBOL_add_exp = 57,                   /* add_exp  */
+  YYSYMBOL_term = 58,                      /* term  */
+  YYSYMBOL_factor = 59,                    /* factor  */
+  YYSYMBOL_call = 60,                      /* call  */
+  YYSYMBOL_61_3 = 61,                      /* @3  */
+  YYSYMBOL_args = 62,                      /* args  */
+  YYSYMBOL_arg_list = 63                   /* arg_list  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
 
-/* Copy the second part of user declarations.  */
 
-#line 196 "y.tab.c" /* yacc.c:358  */
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
 typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -227,15 +411,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -249,47 +446,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -302,34 +495,24 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
 
-/* The parser invokes alloca or malloc; define the necessary symbols.  */
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
-# ifdef YYSTACK_USE_ALLOCA
-#  if YYSTACK_USE_ALLOCA
-#   ifdef __GNUC__
-#    define YYSTACK_ALLOC __builtin_alloca
-#   elif defined __BUILTIN_VA_ARG_INCR
-#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
-#   elif defined _AIX
-#    define YYSTACK_ALLOC __alloca
-#   elif defined _MSC_VER
-#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
-#    define alloca _alloca
-#   else
-#    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
-#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
-#     ifndef EXIT_SUCCESS
-#      define EXIT_SUCCESS 0
-#     endif
-#    endif
-#   endif
-#  endif
-# endif
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
 
 # ifdef YYSTACK_ALLOC
    /* Pacify GCC's 'empty if-body' warning.  */
@@ -368,8 +551,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -378,17 +560,17 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -401,11 +583,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -417,12 +599,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -445,17 +627,20 @@ union yyalloc
 /* YYNSTATES -- Number of states.  */
 #define YYNSTATES  111
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   286
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -489,60 +674,61 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,    38,    38,    42,    55,    57,    58,    60,    65,    70,
-      76,    84,    88,    93,    93,   105,   106,   112,   125,   127,
-     132,   138,   144,   157,   159,   171,   173,   174,   175,   176,
-     177,   179,   180,   182,   188,   195,   201,   205,   210,   215,
-     217,   221,   221,   234,   240,   246,   252,   258,   264,   270,
-     276,   282,   288,   294,   300,   306,   308,   309,   310,   311,
-     316,   316,   325,   326,   328,   340
+       0,    96,    96,   100,   101,   103,   104,   106,   111,   116,
+     122,   130,   134,   139,   139,   151,   152,   158,   159,   161,
+     166,   172,   178,   179,   181,   182,   184,   185,   186,   187,
+     188,   190,   191,   193,   198,   205,   211,   215,   220,   225,
+     227,   228,   228,   241,   247,   253,   259,   265,   271,   277,
+     283,   289,   295,   301,   307,   313,   315,   316,   317,   318,
+     320,   320,   329,   330,   332,   333
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "IF", "ELSE", "WHILE", "RETURN", "INT",
-  "VOID", "ID", "NUM", "EQ", "NE", "LT", "LE", "GT", "GE", "ASSIGN",
-  "PLUS", "MINUS", "TIMES", "OVER", "LPAREN", "RPAREN", "LBRACE", "RBRACE",
-  "LCURLY", "RCURLY", "SEMI", "COMMA", "ERROR", "NO_ELSE", "$accept",
-  "program", "decl_list", "decl", "saveName", "saveNumber", "var_decl",
-  "type_spec", "fun_decl", "@1", "params", "param_list", "param",
-  "comp_stmt", "local_decls", "stmt_list", "stmt", "exp_stmt", "sel_stmt",
-  "iter_stmt", "ret_stmt", "exp", "var", "@2", "simple_exp", "add_exp",
-  "term", "factor", "call", "@3", "args", "arg_list", YY_NULLPTR
+  "\"end of file\"", "error", "\"invalid token\"", "IF", "ELSE", "WHILE",
+  "RETURN", "INT", "VOID", "ID", "NUM", "EQ", "NE", "LT", "LE", "GT", "GE",
+  "ASSIGN", "PLUS", "MINUS", "TIMES", "OVER", "LPAREN", "RPAREN", "LBRACE",
+  "RBRACE", "LCURLY", "RCURLY", "SEMI", "COMMA", "ERROR", "NO_ELSE",
+  "$accept", "program", "decl_list", "decl", "saveName", "saveNumber",
+  "var_decl", "type_spec", "fun_decl", "@1", "params", "param_list",
+  "param", "comp_stmt", "local_decls", "stmt_list", "stmt", "exp_stmt",
+  "sel_stmt", "iter_stmt", "ret_stmt", "exp", "var", "@2", "simple_exp",
+  "add_exp", "term", "factor", "call", "@3", "args", "arg_list", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -53
+#define YYPACT_NINF (-53)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-53)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -61
+#define YYTABLE_NINF (-61)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
        6,   -53,   -53,    17,     6,   -53,   -53,    24,   -53,   -53,
@@ -559,10 +745,10 @@ static const yytype_int8 yypact[] =
      -53
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
        0,    11,    12,     0,     2,     4,     5,     0,     6,     1,
        3,     7,    13,     0,     9,     0,     8,     0,     0,     0,
@@ -578,7 +764,7 @@ static const yytype_uint8 yydefact[] =
       34
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
      -53,   -53,   -53,    98,    -5,    92,    75,    -9,   -53,   -53,
@@ -587,18 +773,18 @@ static const yytype_int8 yypgoto[] =
      -53,   -53
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     3,     4,     5,    45,    46,     6,     7,     8,    15,
+       0,     3,     4,     5,    45,    46,     6,     7,     8,    15,
       21,    22,    23,    47,    34,    37,    48,    49,    50,    51,
       52,    53,    54,    65,    55,    56,    57,    58,    59,    66,
      101,   102
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int8 yytable[] =
 {
       63,    64,    12,    11,    16,    39,    13,    40,    41,    20,
@@ -631,9 +817,9 @@ static const yytype_int8 yycheck[] =
       29,    27
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     7,     8,    33,    34,    35,    38,    39,    40,     0,
       35,     9,    36,    24,    28,    41,    10,    37,    22,    25,
@@ -649,8 +835,8 @@ static const yytype_uint8 yystos[] =
       48
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
        0,    32,    33,    34,    34,    35,    35,    36,    37,    38,
       38,    39,    39,    41,    40,    42,    42,    43,    43,    44,
@@ -661,8 +847,8 @@ static const yytype_uint8 yyr1[] =
       61,    60,    62,    62,    63,    63
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     1,     2,     1,     1,     1,     1,     1,     3,
        6,     1,     1,     0,     7,     1,     1,     3,     1,     2,
@@ -674,39 +860,39 @@ static const yytype_uint8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (p, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -723,55 +909,53 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value); \
+                  Kind, Value, p); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, struct ParserRec * p)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (p);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, struct ParserRec * p)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, p);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -780,7 +964,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -803,21 +987,21 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, struct ParserRec * p)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                                              );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], p);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -825,15 +1009,15 @@ yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, Rule, p); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -854,303 +1038,152 @@ int yydebug;
 #ifndef YYMAXDEPTH
 # define YYMAXDEPTH 10000
 #endif
+/* Parser data structure.  */
+struct yypstate
+  {
+    /* Number of syntax errors so far.  */
+    int yynerrs;
 
+    yy_state_fast_t yystate;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus;
 
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-static YYSIZE_T
-yystrlen (const char *yystr)
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
 
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-        switch (*++yyp)
-          {
-          case '\'':
-          case ',':
-            goto do_not_strip_quotes;
-
-          case '\\':
-            if (*++yyp != '\\')
-              goto do_not_strip_quotes;
-            /* Fall through.  */
-          default:
-            if (yyres)
-              yyres[yyn] = *yyp;
-            yyn++;
-            break;
-
-          case '"':
-            if (yyres)
-              yyres[yyn] = '\0';
-            return yyn;
-          }
-    do_not_strip_quotes: ;
-    }
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize;
 
-  if (! yyres)
-    return yystrlen (yystr);
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss;
+    yy_state_t *yyssp;
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs;
+    YYSTYPE *yyvsp;
+    /* Whether this instance has not started parsing yet.
+     * If 2, it corresponds to a finished parsing.  */
+    int yynew;
+  };
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
 
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
 
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
-  }
 
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
 
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, struct ParserRec * p)
 {
-  YYUSE (yyvaluep);
+  YY_USE (yyvaluep);
+  YY_USE (p);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
-/* The lookahead symbol.  */
-int yychar;
 
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
+#define yynerrs yyps->yynerrs
+#define yystate yyps->yystate
+#define yyerrstatus yyps->yyerrstatus
+#define yyssa yyps->yyssa
+#define yyss yyps->yyss
+#define yyssp yyps->yyssp
+#define yyvsa yyps->yyvsa
+#define yyvs yyps->yyvs
+#define yyvsp yyps->yyvsp
+#define yystacksize yyps->yystacksize
 
+/* Initialize the parser data structure.  */
+static void
+yypstate_clear (yypstate *yyps)
+{
+  yynerrs = 0;
+  yystate = 0;
+  yyerrstatus = 0;
 
-/*----------.
-| yyparse.  |
-`----------*/
+  yyssp = yyss;
+  yyvsp = yyvs;
 
-int
-yyparse (void)
+  /* Initialize the state stack, in case yypcontext_expected_tokens is
+     called before the first call to yyparse. */
+  *yyssp = 0;
+  yyps->yynew = 1;
+}
+
+/* Initialize the parser data structure.  */
+yypstate *
+yypstate_new (void)
 {
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+  yypstate *yyps;
+  yyps = YY_CAST (yypstate *, YYMALLOC (sizeof *yyps));
+  if (!yyps)
+    return YY_NULLPTR;
+  yystacksize = YYINITDEPTH;
+  yyss = yyssa;
+  yyvs = yyvsa;
+  yypstate_clear (yyps);
+  return yyps;
+}
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
+void
+yypstate_delete (yypstate *yyps)
+{
+  if (yyps)
+    {
+#ifndef yyoverflow
+      /* If the stack was reallocated but the parse did not complete, then the
+         stack still needs to be freed.  */
+      if (yyss != yyssa)
+        YYSTACK_FREE (yyss);
+#endif
+      YYFREE (yyps);
+    }
+}
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
-       to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+/*---------------.
+| yypush_parse.  |
+`---------------*/
+
+int
+yypush_parse (yypstate *yyps,
+              int yypushed_char, YYSTYPE const *yypushed_val, struct ParserRec * p)
+{
+/* Lookahead token kind.  */
+int yychar;
 
-    YYSIZE_T yystacksize;
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1158,71 +1191,89 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
+  switch (yyps->yynew)
+    {
+    case 0:
+      yyn = yypact[yystate];
+      goto yyread_pushed_token;
+
+    case 2:
+      yypstate_clear (yyps);
+      break;
+
+    default:
+      break;
+    }
 
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
 
         /* Each stack pointer address is followed by the size of the
            data in use in that stack, in bytes.  This used to be a
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
                     &yystacksize);
-
         yyss = yyss1;
         yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
@@ -1230,30 +1281,31 @@ yyparse (void)
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1264,18 +1316,39 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
+      if (!yyps->yynew)
+        {
+          YYDPRINTF ((stderr, "Return for a new token:\n"));
+          yyresult = YYPUSH_MORE;
+          goto yypushreturn;
+        }
+      yyps->yynew = 0;
+yyread_pushed_token:
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yypushed_char;
+      if (yypushed_val)
+        yylval = *yypushed_val;
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1303,15 +1376,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1326,7 +1397,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1346,484 +1417,450 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 38 "cminus.y" /* yacc.c:1646  */
-    {
-                 savedTree = (yyvsp[0]);
+  case 2: /* program: decl_list  */
+#line 96 "cminus.y"
+                       {
+                 p->savedTree = closeList(yyvsp[0]);
               }
-#line 1355 "y.tab.c" /* yacc.c:1646  */
+#line 1426 "y.tab.c"
     break;
 
-  case 3:
-#line 42 "cminus.y" /* yacc.c:1646  */
-    {
-                   YYSTYPE temp = (yyvsp[-1]);
-                   if (temp == NULL){
-                        (yyval) = (yyvsp[0]); 
-                   }
-                   else{
-                        while (temp->sibling != NULL){
-                            temp = temp->sibling;
-                        }
-                        temp->sibling = (yyvsp[0]);
-                        (yyval) = (yyvsp[-1]);
-                   }
-               }
-#line 1373 "y.tab.c" /* yacc.c:1646  */
+  case 3: /* decl_list: decl_list decl  */
+#line 100 "cminus.y"
+                            { yyval = addDecl(p,yyvsp[-1],yyvsp[0]); }
+#line 1432 "y.tab.c"
     break;
 
-  case 7:
-#line 60 "cminus.y" /* yacc.c:1646  */
-    {
-                savedName = copyString(tokenString);
-                savedLineNo = lineno;
-              }
-#line 1382 "y.tab.c" /* yacc.c:1646  */
+  case 4: /* decl_list: decl  */
+#line 101 "cminus.y"
+                  { yyval = addDecl(p,NOTREE,yyvsp[0]); }
+#line 1438 "y.tab.c"
     break;
 
-  case 8:
-#line 65 "cminus.y" /* yacc.c:1646  */
-    {
-                savedNumber = atoi(tokenString);
-                savedLineNo = lineno;
+  case 7: /* saveName: ID  */
+#line 106 "cminus.y"
+                {
+                p->savedName = p->tok.name;
+                p->savedPos = p->tok.pos;
               }
-#line 1391 "y.tab.c" /* yacc.c:1646  */
+#line 1447 "y.tab.c"
     break;
 
-  case 9:
-#line 70 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newDeclNode(VarK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->lineno = savedLineNo;
-                   (yyval)->attr.name = savedName;
+  case 8: /* saveNumber: NUM  */
+#line 111 "cminus.y"
+                 {
+                p->savedNumber = p->tok.val;
+                p->savedPos = p->tok.pos;
               }
-#line 1402 "y.tab.c" /* yacc.c:1646  */
+#line 1456 "y.tab.c"
     break;
 
-  case 10:
-#line 76 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newDeclNode(ArrVarK);
-                   (yyval)->child[0] = (yyvsp[-5]);
-                   (yyval)->lineno = savedLineNo;
-                   (yyval)->attr.arr.name = savedName;
-                   (yyval)->attr.arr.size = savedNumber;
+  case 9: /* var_decl: type_spec saveName SEMI  */
+#line 116 "cminus.y"
+                                     {
+                   yyval = newDeclNode(VarK);
+                   SETCHILD(yyval,0,yyvsp[-2]);
+                   POS(yyval) = p->savedPos;
+                   ATTR(yyval).name = p->savedName;
               }
-#line 1414 "y.tab.c" /* yacc.c:1646  */
+#line 1467 "y.tab.c"
     break;
 
-  case 11:
-#line 84 "cminus.y" /* yacc.c:1646  */
-    {
-                (yyval) = newTypeNode(TypeNameK);
-                (yyval)->attr.type = INT;
+  case 10: /* var_decl: type_spec saveName LBRACE saveNumber RBRACE SEMI  */
+#line 122 "cminus.y"
+                                                              {
+                   yyval = newDeclNode(ArrVarK);
+                   SETCHILD(yyval,0,yyvsp[-5]);
+                   POS(yyval) = p->savedPos;
+                   ARRNAME(yyval) = p->savedName;
+                   SETARRSIZE(yyval,p->savedNumber);
               }
-#line 1423 "y.tab.c" /* yacc.c:1646  */
+#line 1479 "y.tab.c"
     break;
 
-  case 12:
-#line 88 "cminus.y" /* yacc.c:1646  */
-    {
-                (yyval) = newTypeNode(TypeNameK);
-                (yyval)->attr.type = VOID;
+  case 11: /* type_spec: INT  */
+#line 130 "cminus.y"
+                 {
+                yyval = newTypeNode(TypeNameK);
+                ATTR(yyval).type = INT;
               }
-#line 1432 "y.tab.c" /* yacc.c:1646  */
+#line 1488 "y.tab.c"
     break;
 
-  case 13:
-#line 93 "cminus.y" /* yacc.c:1646  */
-    { 
-                   (yyval) = newDeclNode(FuncK);
-                   (yyval)->lineno = savedLineNo;
-                   (yyval)->attr.name = savedName;
+  case 12: /* type_spec: VOID  */
+#line 134 "cminus.y"
+                  {
+                yyval = newTypeNode(TypeNameK);
+                ATTR(yyval).type = VOID;
               }
-#line 1442 "y.tab.c" /* yacc.c:1646  */
+#line 1497 "y.tab.c"
     break;
 
-  case 14:
-#line 98 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = (yyvsp[-4]);
-                   (yyval)->child[0] = (yyvsp[-6]);
-                   (yyval)->child[1] = (yyvsp[-2]);
-                   (yyval)->child[2] = (yyvsp[0]);
+  case 13: /* @1: %empty  */
+#line 139 "cminus.y"
+                                { 
+                   yyval = newDeclNode(FuncK);
+                   POS(yyval) = p->savedPos;
+                   ATTR(yyval).name = p->savedName;
               }
-#line 1453 "y.tab.c" /* yacc.c:1646  */
+#line 1507 "y.tab.c"
     break;
 
-  case 16:
-#line 106 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newParamNode(NonArrParamK);
-                   (yyval)->child[0] = (yyvsp[0]);
-                   (yyval)->attr.name = copyString("(null)");
+  case 14: /* fun_decl: type_spec saveName @1 LPAREN params RPAREN comp_stmt  */
+#line 144 "cminus.y"
+                                            {
+                   yyval = yyvsp[-4];
+                   SETCHILD(yyval,0,yyvsp[-6]);
+                   SETCHILD(yyval,1,yyvsp[-2]);
+                   SETCHILD(yyval,2,yyvsp[0]);
               }
-#line 1463 "y.tab.c" /* yacc.c:1646  */
+#line 1518 "y.tab.c"
     break;
 
-  case 17:
-#line 112 "cminus.y" /* yacc.c:1646  */
-    {
-                   YYSTYPE temp = (yyvsp[-2]);
-                   if(temp == NULL){
-                       (yyval) = (yyvsp[0]);
-                   }
-                   else{
-                       while (temp->sibling != NULL){
-                           temp = temp->sibling;
-                       }
-                       temp->sibling = (yyvsp[0]);
-                       (yyval) = (yyvsp[-2]); 
-                   }
-              }
-#line 1481 "y.tab.c" /* yacc.c:1646  */
+  case 15: /* params: param_list  */
+#line 151 "cminus.y"
+                        { yyval = closeList(yyvsp[0]); }
+#line 1524 "y.tab.c"
     break;
 
-  case 19:
-#line 127 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newParamNode(NonArrParamK);
-                   (yyval)->child[0] = (yyvsp[-1]);
-                   (yyval)->attr.name = savedName;
+  case 16: /* params: type_spec  */
+#line 152 "cminus.y"
+                       {
+                   yyval = newParamNode(NonArrParamK);
+                   SETCHILD(yyval,0,yyvsp[0]);
+                   ATTR(yyval).name = p->nullName;
               }
-#line 1491 "y.tab.c" /* yacc.c:1646  */
+#line 1534 "y.tab.c"
     break;
 
-  case 20:
-#line 132 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newParamNode(ArrParamK);
-                   (yyval)->child[0] = (yyvsp[-3]);
-                   (yyval)->attr.name = savedName;
+  case 17: /* param_list: param_list COMMA param  */
+#line 158 "cminus.y"
+                                    { yyval = appendList(yyvsp[-2],yyvsp[0]); }
+#line 1540 "y.tab.c"
+    break;
+
+  case 18: /* param_list: param  */
+#line 159 "cminus.y"
+                   { yyval = appendList(NOTREE,yyvsp[0]); }
+#line 1546 "y.tab.c"
+    break;
+
+  case 19: /* param: type_spec saveName  */
+#line 161 "cminus.y"
+                                {
+                   yyval = newParamNode(NonArrParamK);
+                   SETCHILD(yyval,0,yyvsp[-1]);
+                   ATTR(yyval).name = p->savedName;
               }
-#line 1501 "y.tab.c" /* yacc.c:1646  */
+#line 1556 "y.tab.c"
     break;
 
-  case 21:
-#line 138 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newStmtNode(CompK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[-1]);
+  case 20: /* param: type_spec saveName LBRACE RBRACE  */
+#line 166 "cminus.y"
+                                              {
+                   yyval = newParamNode(ArrParamK);
+                   SETCHILD(yyval,0,yyvsp[-3]);
+                   ATTR(yyval).name = p->savedName;
               }
-#line 1511 "y.tab.c" /* yacc.c:1646  */
+#line 1566 "y.tab.c"
     break;
 
-  case 22:
-#line 144 "cminus.y" /* yacc.c:1646  */
-    {
-                   YYSTYPE temp = (yyvsp[-1]);
-                   if(temp == NULL){
-                        (yyval) = (yyvsp[0]);
-                   }
-                   else{
-                        while (temp->sibling != NULL){
-                            temp = temp->sibling;
-                        }
-                        temp->sibling = (yyvsp[0]);
-                        (yyval) = (yyvsp[-1]); 
-                   }
+  case 21: /* comp_stmt: LCURLY local_decls stmt_list RCURLY  */
+#line 172 "cminus.y"
+                                                 {
+                   yyval = newStmtNode(CompK);
+                   SETCHILD(yyval,0,closeList(yyvsp[-2]));
+                   SETCHILD(yyval,1,closeList(yyvsp[-1]));
               }
-#line 1529 "y.tab.c" /* yacc.c:1646  */
+#line 1576 "y.tab.c"
     break;
 
-  case 23:
-#line 157 "cminus.y" /* yacc.c:1646  */
-    { (yyval) = NULL; }
-#line 1535 "y.tab.c" /* yacc.c:1646  */
+  case 22: /* local_decls: local_decls var_decl  */
+#line 178 "cminus.y"
+                                  { yyval = appendList(yyvsp[-1],yyvsp[0]); }
+#line 1582 "y.tab.c"
     break;
 
-  case 24:
-#line 159 "cminus.y" /* yacc.c:1646  */
-    {
-                   YYSTYPE temp = (yyvsp[-1]);
-                   if(temp == NULL){
-                        (yyval) = (yyvsp[0]);
-                   }
-                   else{
-                        while (temp->sibling != NULL)
-                            temp = temp->sibling;
-                        temp->sibling = (yyvsp[0]);
-                        (yyval) = (yyvsp[-1]); 
-                   }
-              }
-#line 1552 "y.tab.c" /* yacc.c:1646  */
+  case 23: /* local_decls: %empty  */
+#line 179 "cminus.y"
+              { yyval = NOTREE; }
+#line 1588 "y.tab.c"
     break;
 
-  case 25:
-#line 171 "cminus.y" /* yacc.c:1646  */
-    { (yyval) = NULL; }
-#line 1558 "y.tab.c" /* yacc.c:1646  */
+  case 24: /* stmt_list: stmt_list stmt  */
+#line 181 "cminus.y"
+                            { yyval = appendList(yyvsp[-1],yyvsp[0]); }
+#line 1594 "y.tab.c"
     break;
 
-  case 31:
-#line 179 "cminus.y" /* yacc.c:1646  */
-    { (yyval)= (yyvsp[-1]); }
-#line 1564 "y.tab.c" /* yacc.c:1646  */
+  case 25: /* stmt_list: %empty  */
+#line 182 "cminus.y"
+              { yyval = NOTREE; }
+#line 1600 "y.tab.c"
     break;
 
-  case 32:
-#line 180 "cminus.y" /* yacc.c:1646  */
-    { (yyval) = NULL; }
-#line 1570 "y.tab.c" /* yacc.c:1646  */
+  case 31: /* exp_stmt: exp SEMI  */
+#line 190 "cminus.y"
+                       { yyval= yyvsp[-1]; }
+#line 1606 "y.tab.c"
     break;
 
-  case 33:
-#line 182 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newStmtNode(IfK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[0]);
-                   (yyval)->child[2] = NULL;
-              }
-#line 1581 "y.tab.c" /* yacc.c:1646  */
+  case 32: /* exp_stmt: SEMI  */
+#line 191 "cminus.y"
+                    { yyval = NOTREE; }
+#line 1612 "y.tab.c"
     break;
 
-  case 34:
-#line 188 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newStmtNode(IfEK);
-                   (yyval)->child[0] = (yyvsp[-4]);
-                   (yyval)->child[1] = (yyvsp[-2]);
-                   (yyval)->child[2] = (yyvsp[0]);
+  case 33: /* sel_stmt: IF LPAREN exp RPAREN stmt  */
+#line 193 "cminus.y"
+                                                     {
+                   yyval = newStmtNode(IfK);
+                   SETCHILD(yyval,0,yyvsp[-2]);
+                   SETCHILD(yyval,1,yyvsp[0]);
               }
-#line 1592 "y.tab.c" /* yacc.c:1646  */
+#line 1622 "y.tab.c"
     break;
 
-  case 35:
-#line 195 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newStmtNode(IterK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[0]);
+  case 34: /* sel_stmt: IF LPAREN exp RPAREN stmt ELSE stmt  */
+#line 198 "cminus.y"
+                                                 {
+                   yyval = newStmtNode(IfEK);
+                   SETCHILD(yyval,0,yyvsp[-4]);
+                   SETCHILD(yyval,1,yyvsp[-2]);
+                   SETCHILD(yyval,2,yyvsp[0]);
               }
-#line 1602 "y.tab.c" /* yacc.c:1646  */
+#line 1633 "y.tab.c"
     break;
 
-  case 36:
-#line 201 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newStmtNode(RetK);
-                   (yyval)->child[0] = NULL;
+  case 35: /* iter_stmt: WHILE LPAREN exp RPAREN stmt  */
+#line 205 "cminus.y"
+                                          {
+                   yyval = newStmtNode(IterK);
+                   SETCHILD(yyval,0,yyvsp[-2]);
+                   SETCHILD(yyval,1,yyvsp[0]);
               }
-#line 1611 "y.tab.c" /* yacc.c:1646  */
+#line 1643 "y.tab.c"
     break;
 
-  case 37:
-#line 205 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newStmtNode(RetK);
-                   (yyval)->child[0] = (yyvsp[-1]);
+  case 36: /* ret_stmt: RETURN SEMI  */
+#line 211 "cminus.y"
+                         {
+                   yyval = newStmtNode(RetK);
+                   SETCHILD(yyval,0,NOTREE);
               }
-#line 1620 "y.tab.c" /* yacc.c:1646  */
+#line 1652 "y.tab.c"
     break;
 
-  case 38:
-#line 210 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newExpNode(AssignK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[0]);
+  case 37: /* ret_stmt: RETURN exp SEMI  */
+#line 215 "cminus.y"
+                             {
+                   yyval = newStmtNode(RetK);
+                   SETCHILD(yyval,0,yyvsp[-1]);
               }
-#line 1630 "y.tab.c" /* yacc.c:1646  */
+#line 1661 "y.tab.c"
     break;
 
-  case 40:
-#line 217 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newExpNode(IdK);
-                   (yyval)->attr.name = savedName;
+  case 38: /* exp: var ASSIGN exp  */
+#line 220 "cminus.y"
+                            {
+                   yyval = newExpNode(AssignK);
+                   SETCHILD(yyval,0,yyvsp[-2]);
+                   SETCHILD(yyval,1,yyvsp[0]);
               }
-#line 1639 "y.tab.c" /* yacc.c:1646  */
+#line 1671 "y.tab.c"
     break;
 
-  case 41:
-#line 221 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newExpNode(ArrIdK);
-                   (yyval)->attr.name = savedName;
+  case 40: /* var: saveName  */
+#line 227 "cminus.y"
+                      { yyval = newIdLeaf(p->savedName); }
+#line 1677 "y.tab.c"
+    break;
+
+  case 41: /* @2: %empty  */
+#line 228 "cminus.y"
+                      {
+                   yyval = newExpNode(ArrIdK);
+                   ATTR(yyval).name = p->savedName;
               }
-#line 1648 "y.tab.c" /* yacc.c:1646  */
+#line 1686 "y.tab.c"
     break;
 
-  case 42:
-#line 225 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = (yyvsp[-3]);
-                   (yyval)->child[0] = (yyvsp[-1]);
+  case 42: /* var: saveName @2 LBRACE exp RBRACE  */
+#line 232 "cminus.y"
+                               {
+                   yyval = yyvsp[-3];
+                   SETCHILD(yyval,0,yyvsp[-1]);
               }
-#line 1657 "y.tab.c" /* yacc.c:1646  */
+#line 1695 "y.tab.c"
     break;
 
-  case 43:
-#line 234 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newExpNode(OpK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[0]);
-                   (yyval)->attr.op = LE;
+  case 43: /* simple_exp: add_exp LE add_exp  */
+#line 241 "cminus.y"
+                                {
+                   yyval = newExpNode(OpK);
+                   SETCHILD(yyval,0,yyvsp[-2]);
+                   SETCHILD(yyval,1,yyvsp[0]);
+                   ATTR(yyval).op = LE;
               }
-#line 1668 "y.tab.c" /* yacc.c:1646  */
+#line 1706 "y.tab.c"
     break;
 
-  case 44:
-#line 240 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newExpNode(OpK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[0]);
-                   (yyval)->attr.op = LT;
+  case 44: /* simple_exp: add_exp LT add_exp  */
+#line 247 "cminus.y"
+                                {
+                   yyval = newExpNode(OpK);
+                   SETCHILD(yyval,0,yyvsp[-2]);
+                   SETCHILD(yyval,1,yyvsp[0]);
+                   ATTR(yyval).op = LT;
               }
-#line 1679 "y.tab.c" /* yacc.c:1646  */
+#line 1717 "y.tab.c"
     break;
 
-  case 45:
-#line 246 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newExpNode(OpK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[0]);
-                   (yyval)->attr.op = GT;
+  case 45: /* simple_exp: add_exp GT add_exp  */
+#line 253 "cminus.y"
+                                {
+                   yyval = newExpNode(OpK);
+                   SETCHILD(yyval,0,yyvsp[-2]);
+                   SETCHILD(yyval,1,yyvsp[0]);
+                   ATTR(yyval).op = GT;
               }
-#line 1690 "y.tab.c" /* yacc.c:1646  */
+#line 1728 "y.tab.c"
     break;
 
-  case 46:
-#line 252 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newExpNode(OpK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[0]);
-                   (yyval)->attr.op = GE;
+  case 46: /* simple_exp: add_exp GE add_exp  */
+#line 259 "cminus.y"
+                                {
+                   yyval = newExpNode(OpK);
+                   SETCHILD(yyval,0,yyvsp[-2]);
+                   SETCHILD(yyval,1,yyvsp[0]);
+                   ATTR(yyval).op = GE;
               }
-#line 1701 "y.tab.c" /* yacc.c:1646  */
+#line 1739 "y.tab.c"
     break;
 
-  case 47:
-#line 258 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newExpNode(OpK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[0]);
-                   (yyval)->attr.op = EQ;
+  case 47: /* simple_exp: add_exp EQ add_exp  */
+#line 265 "cminus.y"
+                                {
+                   yyval = newExpNode(OpK);
+                   SETCHILD(yyval,0,yyvsp[-2]);
+                   SETCHILD(yyval,1,yyvsp[0]);
+                   ATTR(yyval).op = EQ;
               }
-#line 1712 "y.tab.c" /* yacc.c:1646  */
+#line 1750 "y.tab.c"
     break;
 
-  case 48:
-#line 264 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newExpNode(OpK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[0]);
-                   (yyval)->attr.op = NE;
+  case 48: /* simple_exp: add_exp NE add_exp  */
+#line 271 "cminus.y"
+                                {
+                   yyval = newExpNode(OpK);
+                   SETCHILD(yyval,0,yyvsp[-2]);
+                   SETCHILD(yyval,1,yyvsp[0]);
+                   ATTR(yyval).op = NE;
               }
-#line 1723 "y.tab.c" /* yacc.c:1646  */
+#line 1761 "y.tab.c"
     break;
 
-  case 50:
-#line 276 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newExpNode(OpK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[0]);
-                   (yyval)->attr.op = PLUS;
+  case 50: /* add_exp: add_exp PLUS term  */
+#line 283 "cminus.y"
+                               {
+                   yyval = newExpNode(OpK);
+                   SETCHILD(yyval,0,yyvsp[-2]);
+                   SETCHILD(yyval,1,yyvsp[0]);
+                   ATTR(yyval).op = PLUS;
               }
-#line 1734 "y.tab.c" /* yacc.c:1646  */
+#line 1772 "y.tab.c"
     break;
 
-  case 51:
-#line 282 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newExpNode(OpK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[0]);
-                   (yyval)->attr.op = MINUS;
+  case 51: /* add_exp: add_exp MINUS term  */
+#line 289 "cminus.y"
+                                {
+                   yyval = newExpNode(OpK);
+                   SETCHILD(yyval,0,yyvsp[-2]);
+                   SETCHILD(yyval,1,yyvsp[0]);
+                   ATTR(yyval).op = MINUS;
               }
-#line 1745 "y.tab.c" /* yacc.c:1646  */
+#line 1783 "y.tab.c"
     break;
 
-  case 53:
-#line 294 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newExpNode(OpK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[0]);
-                   (yyval)->attr.op = TIMES;
+  case 53: /* term: term TIMES factor  */
+#line 301 "cminus.y"
+                               {
+                   yyval = newExpNode(OpK);
+                   SETCHILD(yyval,0,yyvsp[-2]);
+                   SETCHILD(yyval,1,yyvsp[0]);
+                   ATTR(yyval).op = TIMES;
               }
-#line 1756 "y.tab.c" /* yacc.c:1646  */
+#line 1794 "y.tab.c"
     break;
 
-  case 54:
-#line 300 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newExpNode(OpK);
-                   (yyval)->child[0] = (yyvsp[-2]);
-                   (yyval)->child[1] = (yyvsp[0]);
-                   (yyval)->attr.op = OVER;
+  case 54: /* term: term OVER factor  */
+#line 307 "cminus.y"
+                              {
+                   yyval = newExpNode(OpK);
+                   SETCHILD(yyval,0,yyvsp[-2]);
+                   SETCHILD(yyval,1,yyvsp[0]);
+                   ATTR(yyval).op = OVER;
               }
-#line 1767 "y.tab.c" /* yacc.c:1646  */
+#line 1805 "y.tab.c"
     break;
 
-  case 56:
-#line 308 "cminus.y" /* yacc.c:1646  */
-    { (yyval) = (yyvsp[-1]); }
-#line 1773 "y.tab.c" /* yacc.c:1646  */
+  case 56: /* factor: LPAREN exp RPAREN  */
+#line 315 "cminus.y"
+                                { yyval = yyvsp[-1]; }
+#line 1811 "y.tab.c"
     break;
 
-  case 59:
-#line 311 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newExpNode(ConstK);
-                   (yyval)->attr.val = savedNumber;
-              }
-#line 1782 "y.tab.c" /* yacc.c:1646  */
+  case 59: /* factor: saveNumber  */
+#line 318 "cminus.y"
+                        { yyval = newConstLeaf(p->savedNumber); }
+#line 1817 "y.tab.c"
     break;
 
-  case 60:
-#line 316 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = newExpNode(CallK);
-                   (yyval)->attr.name = savedName;
+  case 60: /* @3: %empty  */
+#line 320 "cminus.y"
+                      {
+                   yyval = newExpNode(CallK);
+                   ATTR(yyval).name = p->savedName;
               }
-#line 1791 "y.tab.c" /* yacc.c:1646  */
+#line 1826 "y.tab.c"
     break;
 
-  case 61:
-#line 320 "cminus.y" /* yacc.c:1646  */
-    {
-                   (yyval) = (yyvsp[-3]);
-                   (yyval)->child[0] = (yyvsp[-1]);
+  case 61: /* call: saveName @3 LPAREN args RPAREN  */
+#line 324 "cminus.y"
+                                {
+                   yyval = yyvsp[-3];
+                   SETCHILD(yyval,0,yyvsp[-1]);
               }
-#line 1800 "y.tab.c" /* yacc.c:1646  */
+#line 1835 "y.tab.c"
     break;
 
-  case 63:
-#line 326 "cminus.y" /* yacc.c:1646  */
-    { (yyval) = NULL; }
-#line 1806 "y.tab.c" /* yacc.c:1646  */
+  case 62: /* args: arg_list  */
+#line 329 "cminus.y"
+                      { yyval = closeList(yyvsp[0]); }
+#line 1841 "y.tab.c"
     break;
 
-  case 64:
-#line 328 "cminus.y" /* yacc.c:1646  */
-    {
-                   YYSTYPE temp = (yyvsp[-2]);
-                   if(temp == NULL){
-                        (yyval) = (yyvsp[0]);
-                   }
-                   else{
-                        while (temp->sibling != NULL)
-                            temp = temp->sibling;
-                        temp->sibling = (yyvsp[0]);
-                        (yyval) = (yyvsp[-2]); 
-                   }
-              }
-#line 1823 "y.tab.c" /* yacc.c:1646  */
+  case 63: /* args: %empty  */
+#line 330 "cminus.y"
+              { yyval = NOTREE; }
+#line 1847 "y.tab.c"
     break;
 
+  case 64: /* arg_list: arg_list COMMA exp  */
+#line 332 "cminus.y"
+                                { yyval = appendList(yyvsp[-2],yyvsp[0]); }
+#line 1853 "y.tab.c"
+    break;
+
+  case 65: /* arg_list: exp  */
+#line 333 "cminus.y"
+                 { yyval = appendList(NOTREE,yyvsp[0]); }
+#line 1859 "y.tab.c"
+    break;
+
+
+#line 1863 "y.tab.c"
 
-#line 1827 "y.tab.c" /* yacc.c:1646  */
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -1837,25 +1874,23 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -1866,50 +1901,14 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
+      yyerror (p, YY_("syntax error"));
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -1924,7 +1923,7 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval);
+                      yytoken, &yylval, p);
           yychar = YYEMPTY;
         }
     }
@@ -1938,12 +1937,11 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -1960,13 +1958,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -1980,7 +1979,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, p);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -1992,7 +1991,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2003,33 +2002,37 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (p, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, p);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -2038,38 +2041,120 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, p);
       YYPOPSTACK (1);
     }
-#ifndef yyoverflow
-  if (yyss != yyssa)
-    YYSTACK_FREE (yyss);
-#endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  return yyresult;
-}
-#line 343 "cminus.y" /* yacc.c:1906  */
+  yyps->yynew = 2;
+  goto yypushreturn;
+
 
+/*-------------------------.
+| yypushreturn -- return.  |
+`-------------------------*/
+yypushreturn:
 
-int yyerror(char * message)
-{ fprintf(listing,"Syntax error at line %d: %s\n",lineno,message);
+  return yyresult;
+}
+#undef yynerrs
+#undef yystate
+#undef yyerrstatus
+#undef yyssa
+#undef yyss
+#undef yyssp
+#undef yyvsa
+#undef yyvs
+#undef yyvsp
+#undef yystacksize
+#line 336 "cminus.y"
+
+
+static int yyerror(Parser p, char * message)
+{ if (p->muted) return 0;
+  fprintf(listing,"Syntax error at line %d, column %d: %s\n",
+          lineOf(p->tok.pos),columnOf(p->tok.pos),message);
   fprintf(listing,"Current token: ");
-  printToken(yychar,tokenString);
+  { char * lexeme = copySpan(p->tok.span);
+    printToken(p->tok.kind,lexeme);
+    free(lexeme);
+  }
   Error = TRUE;
   return 0;
 }
 
-/* yylex calls getToken to make Yacc/Bison output
- * compatible with ealier versions of the TINY scanner
- */
-static int yylex(void)
-{ return getToken(); }
+Parser newParser(void)
+{ Parser p = calloc(1,sizeof(struct ParserRec));
+  if (p == NULL || (p->ps = yypstate_new()) == NULL)
+  { fprintf(listing,"Out of memory error creating a parser\n");
+    exit(1);
+  }
+  p->nullName = intern("(null)",6);
+  p->savedTree = NOTREE;
+  p->status = YYPUSH_MORE;
+  return p;
+}
 
-TreeNode * parse(void)
-{ yyparse();
-  return savedTree;
+int pushToken(Parser p, Token * tok)
+{ YYSTYPE none = NOTREE;
+  if (p->status != YYPUSH_MORE) return FALSE;
+  p->tok = *tok;
+  srcpos = tok->pos; /* for the nodes made now */
+  p->status = yypush_parse(p->ps,tok->kind,&none,p);
+  return p->status == YYPUSH_MORE;
 }
 
+void streamDecls(Parser p, DeclProc proc)
+{ p->declProc = proc; }
+
+void muteParser(Parser p)
+{ p->muted = TRUE; }
+
+Tree parserTree(Parser p)
+{ return p->status == 0 ? p->savedTree : NOTREE; }
+
+void freeParser(Parser p)
+{ yypstate_delete(p->ps);
+  free(p);
+}
+
+/* pullParse pulls the tokens from getToken and
+ * pushes them into a parser of its own, which hands
+ * the declarations to proc unless it is NULL
+ */
+static Tree pullParse(DeclProc proc)
+{ Parser p;
+  Token tok;
+  Tree t;
+  if (ParallelParse && proc == NULL &&
+      (ScanMode == BatchScan || ScanMode == ParallelScan))
+  { t = parseParallel();
+    /* otherwise parsed again serially, which
+       reports any syntax error */
+    if (t != NOTREE) return t;
+  }
+  if (DescentParse)
+  { t = descentParse(proc);
+    endTokens();
+    return t;
+  }
+  /* made before a scanner thread may start, as
+     it interns a name */
+  p = newParser();
+  streamDecls(p,proc);
+  do
+  { tok.kind = getToken();
+    tok.span = tokenSpan;
+    tok.pos = srcpos;
+    tok.val = tokenValue;
+    tok.name = tokenName;
+  } while (pushToken(p,&tok));
+  endTokens();
+  t = parserTree(p);
+  freeParser(p);
+  return t;
+}
+
+Tree parse(void)
+{ return pullParse(NULL); }
+
+void streamParse(DeclProc proc)
+{ pullParse(proc); }